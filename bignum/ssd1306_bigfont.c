@@ -7,13 +7,12 @@
  * 
  * Optimizaciones:
  * - Tabla precalculada para divisiones (evita / y % costosos en 6502)
- * - Máscaras precalculadas (evita shifts variables)
- * - Funciones unificadas
+ * - Columnas expandidas por tabla (un acceso por página, sin bucles de bits)
+ * - Texto completo en una sola ventana (una transacción por cadena)
  */
 
 #include "ssd1306_bigfont.h"
 #include "../core/ssd1306_core.h"
-#include "../../i2c/i2c.h"
 
 #if SSD1306_USE_BIGNUM
 
@@ -39,9 +38,6 @@ static const uint8_t mod10[100] = {
     0,1,2,3,4,5,6,7,8,9, 0,1,2,3,4,5,6,7,8,9
 };
 
-/* Máscaras de bit precalculadas (evita 0x01 << n) */
-static const uint8_t bit_mask[5] = {0x01, 0x02, 0x04, 0x08, 0x10};
-
 /* ============================================
  * DEFINICIÓN DE CARACTERES 5×5
  * ============================================ */
@@ -127,100 +123,69 @@ static const uint8_t* get_char_pattern(char c) {
 }
 
 /* 
- * Patrones de bloque para cada fila (3 píxeles de alto)
- * Cada fila de bloques contribuye bits a página 0 y/o página 1
+ * Expansión de columnas: cada columna del patrón (5 bits, una fila de
+ * bloques por bit) se convierte en un byte por página.
  * 
  * Fila 0: píxeles 0-2  → página 0: bits 0,1,2 = 0x07
  * Fila 1: píxeles 3-5  → página 0: bits 3,4,5 = 0x38
  * Fila 2: píxeles 6-8  → página 0: bits 6,7 = 0xC0, página 1: bit 0 = 0x01
  * Fila 3: píxeles 9-11 → página 1: bits 1,2,3 = 0x0E
  * Fila 4: píxeles 12-14→ página 1: bits 4,5,6 = 0x70
+ * 
+ * expand_p0[v] / expand_p1[v] = OR de los patrones de las filas de v.
  */
+static const uint8_t expand_p0[32] = {
+    0x00, 0x07, 0x38, 0x3F, 0xC0, 0xC7, 0xF8, 0xFF,
+    0x00, 0x07, 0x38, 0x3F, 0xC0, 0xC7, 0xF8, 0xFF,
+    0x00, 0x07, 0x38, 0x3F, 0xC0, 0xC7, 0xF8, 0xFF,
+    0x00, 0x07, 0x38, 0x3F, 0xC0, 0xC7, 0xF8, 0xFF
+};
 
-/* Patrón para página 0 por cada fila de bloques */
-static const uint8_t row_pattern_p0[5] = {0x07, 0x38, 0xC0, 0x00, 0x00};
-/* Patrón para página 1 por cada fila de bloques */
-static const uint8_t row_pattern_p1[5] = {0x00, 0x00, 0x01, 0x0E, 0x70};
+static const uint8_t expand_p1[32] = {
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01,
+    0x0E, 0x0E, 0x0E, 0x0E, 0x0F, 0x0F, 0x0F, 0x0F,
+    0x70, 0x70, 0x70, 0x70, 0x71, 0x71, 0x71, 0x71,
+    0x7E, 0x7E, 0x7E, 0x7E, 0x7F, 0x7F, 0x7F, 0x7F
+};
 
-/* Dibujar un carácter grande (OPTIMIZADO: usa máscaras precalculadas) */
-void ssd1306_bigchar(uint8_t x, uint8_t page, char c) {
+/*
+ * Enviar una página de la cadena: n bytes exactos (la ventana ya está
+ * abierta). Cada columna de bloques son 3 bytes iguales; entre
+ * caracteres va una columna vacía.
+ */
+static void bigtext_row(const char *str, const uint8_t *expand, uint8_t n) {
     const uint8_t *pattern;
-    uint8_t data_col;      /* Columna de datos (0-4) */
-    uint8_t px_col;        /* Columna de píxeles dentro del bloque (0-2) */
-    uint8_t data_row;      /* Fila de datos (0-4) */
-    uint8_t col_bits;      /* Bits activos de la columna */
-    uint8_t byte_p0, byte_p1;
+    uint8_t col, k;
     
-    pattern = get_char_pattern(c);
-    
-    /* Dibujar página superior */
-    ssd1306_set_pos(x, page);
-    i2c_start(SSD1306_ADDR, I2C_WRITE);
-    i2c_write_byte(SSD1306_DATA);
-    
-    for (data_col = 0; data_col < 5; data_col++) {
-        col_bits = pattern[data_col];
-        
-        /* Calcular byte para página 0 usando máscaras precalculadas */
-        byte_p0 = 0;
-        for (data_row = 0; data_row < 5; data_row++) {
-            if (col_bits & bit_mask[data_row]) {
-                byte_p0 |= row_pattern_p0[data_row];
-            }
+    while (n) {
+        pattern = get_char_pattern(*str++);
+        for (col = 0; col < BIGFONT_COLS && n; col++) {
+            k = (n < BIGFONT_BLOCK_W) ? n : BIGFONT_BLOCK_W;
+            ssd1306_data_repeat(expand[pattern[col]], k);
+            n -= k;
         }
-        
-        /* Escribir 3 veces (3 píxeles de ancho por bloque) */
-        for (px_col = 0; px_col < 3; px_col++) {
-            i2c_write_byte(byte_p0);
+        if (n) {
+            ssd1306_data_put(0x00);     /* Espacio entre caracteres */
+            n--;
         }
     }
-    i2c_stop();
-    
-    /* Dibujar página inferior */
-    ssd1306_set_pos(x, page + 1);
-    i2c_start(SSD1306_ADDR, I2C_WRITE);
-    i2c_write_byte(SSD1306_DATA);
+}
+
+/* Dibujar un carácter grande */
+void ssd1306_bigchar(uint8_t x, uint8_t page, char c) {
+    char str[2];
     
-    for (data_col = 0; data_col < 5; data_col++) {
-        col_bits = pattern[data_col];
-        
-        /* Calcular byte para página 1 usando máscaras precalculadas */
-        byte_p1 = 0;
-        for (data_row = 0; data_row < 5; data_row++) {
-            if (col_bits & bit_mask[data_row]) {
-                byte_p1 |= row_pattern_p1[data_row];
-            }
-        }
-        
-        /* Escribir 3 veces */
-        for (px_col = 0; px_col < 3; px_col++) {
-            i2c_write_byte(byte_p1);
-        }
-    }
-    i2c_stop();
+    str[0] = c;
+    str[1] = '\0';
+    ssd1306_bigtext(x, page, str);
 }
 
 /* Limpiar área de un caracter grande */
 void ssd1306_bigchar_clear(uint8_t x, uint8_t page) {
-    uint8_t i;
-    
-    /* Limpiar página superior */
-    ssd1306_set_pos(x, page);
-    i2c_start(SSD1306_ADDR, I2C_WRITE);
-    i2c_write_byte(SSD1306_DATA);
-    for (i = 0; i < 15; i++) {
-        i2c_write_byte(0x00);
-    }
-    i2c_stop();
-    
-    /* Limpiar página inferior */
-    ssd1306_set_pos(x, page + 1);
-    i2c_start(SSD1306_ADDR, I2C_WRITE);
-    i2c_write_byte(SSD1306_DATA);
-    for (i = 0; i < 15; i++) {
-        i2c_write_byte(0x00);
-    }
-    i2c_stop();
+    /* Ventana de 15x2: 30 bytes en 1 transacción */
+    ssd1306_window_begin(x, x + 14, page, page + 1);
+    ssd1306_data_repeat(0x00, 30);
+    ssd1306_data_end();
 }
 
 /* ============================================
@@ -235,15 +200,22 @@ uint8_t ssd1306_bigtext_width(const char *str) {
     return (len * BIGFONT_CHAR_W) + ((len - 1) * BIGFONT_SPACING);
 }
 
-/* Dibujar texto grande en posición específica */
+/* Dibujar texto grande: ventana de ancho x 2 páginas, 1 transacción.
+ * Lo que pasa del borde derecho se recorta. */
 void ssd1306_bigtext(uint8_t x, uint8_t page, const char *str) {
-    uint8_t pos = x;
+    uint16_t end = x;
+    const char *s = str;
     
-    while (*str && pos < 128) {
-        ssd1306_bigchar(pos, page, *str);
-        pos += BIGFONT_CHAR_W + BIGFONT_SPACING;
-        str++;
-    }
+    if (!*str || x >= SSD1306_WIDTH) return;
+    
+    while (*s++) end += BIGFONT_CHAR_W + BIGFONT_SPACING;
+    end -= BIGFONT_SPACING + 1;     /* Última columna del último carácter */
+    if (end > SSD1306_WIDTH - 1) end = SSD1306_WIDTH - 1;
+    
+    ssd1306_window_begin(x, (uint8_t)end, page, page + 1);
+    bigtext_row(str, expand_p0, (uint8_t)end - x + 1);
+    bigtext_row(str, expand_p1, (uint8_t)end - x + 1);
+    ssd1306_data_end();
 }
 
 /* Dibujar texto grande centrado verticalmente (1 línea) */
@@ -255,7 +227,7 @@ void ssd1306_bigtext_centered(const char *str) {
 /* Dibujar texto centrado horizontal y verticalmente */
 void ssd1306_bigtext_center(const char *str) {
     uint8_t width = ssd1306_bigtext_width(str);
-    uint8_t x = (128 - width) / 2;
+    uint8_t x = (SSD1306_WIDTH - width) / 2;
     
     ssd1306_bigtext(x, BIGFONT_CENTER, str);
 }
@@ -277,58 +249,157 @@ void ssd1306_bignum_colon(uint8_t x, uint8_t page) {
 
 /* Dibujar número de 2 dígitos (usa tablas precalculadas) */
 void ssd1306_bignum_2digit(uint8_t x, uint8_t page, uint8_t num) {
+    char str[3];
+    
     if (num > 99) num = 99;
-    ssd1306_bigchar(x, page, '0' + div10[num]);
-    ssd1306_bigchar(x + BIGFONT_CHAR_W + BIGFONT_SPACING, page, '0' + mod10[num]);
+    str[0] = '0' + div10[num];
+    str[1] = '0' + mod10[num];
+    str[2] = '\0';
+    ssd1306_bigtext(x, page, str);
 }
 
-/* Dibujar hora HH:MM en posición específica (usa tablas precalculadas) */
-void ssd1306_bignum_time(uint8_t x, uint8_t page, uint8_t hours, uint8_t minutes) {
-    uint8_t pos = x;
-    
-    /* HH */
-    ssd1306_bigchar(pos, page, '0' + div10[hours]);
-    pos += BIGFONT_CHAR_W + BIGFONT_SPACING;
-    ssd1306_bigchar(pos, page, '0' + mod10[hours]);
-    pos += BIGFONT_CHAR_W + BIGFONT_SPACING;
-    
-    /* : */
-    ssd1306_bigchar(pos, page, ':');
-    pos += BIGFONT_CHAR_W + BIGFONT_SPACING;
+/* Escribir HH:MM (y :SS si seconds <= 99) en str. Retorna la longitud */
+static uint8_t time_str(char *str, uint8_t hours, uint8_t minutes, uint8_t seconds) {
+    uint8_t len = 5;
     
-    /* MM */
-    ssd1306_bigchar(pos, page, '0' + div10[minutes]);
-    pos += BIGFONT_CHAR_W + BIGFONT_SPACING;
-    ssd1306_bigchar(pos, page, '0' + mod10[minutes]);
-}
-
-/* Dibujar hora HH:MM centrada (constantes precalculadas) */
-void ssd1306_bignum_time_centered(uint8_t hours, uint8_t minutes) {
-    /* HH:MM = 5 caracteres, ancho = 5*15 + 4*1 = 79px */
-    /* x = (128 - 79) / 2 = 24 (constante) */
-    ssd1306_bignum_time(24, BIGFONT_CENTER, hours, minutes);
+    if (hours > 99) hours = 99;
+    if (minutes > 99) minutes = 99;
+    str[0] = '0' + div10[hours];
+    str[1] = '0' + mod10[hours];
+    str[2] = ':';
+    str[3] = '0' + div10[minutes];
+    str[4] = '0' + mod10[minutes];
+    if (seconds <= 99) {
+        str[5] = ':';
+        str[6] = '0' + div10[seconds];
+        str[7] = '0' + mod10[seconds];
+        len = 8;
+    }
+    str[len] = '\0';
+    return len;
 }
 
-/* Dibujar número grande (0-9999) usando tablas */
-void ssd1306_bignum_number(uint8_t x, uint8_t page, uint16_t num, uint8_t digits) {
+/* Escribir los últimos digits dígitos de num (0-9999) en str */
+static uint8_t number_str(char *str, uint16_t num, uint8_t digits) {
     uint8_t d[4];
     uint8_t i;
-    uint8_t pos = x;
     uint8_t h, l;
     
     /* Dividir en high (num/100) y low (num%100) */
     h = num / 100;
     l = num - (h * 100);  /* Más eficiente que % */
+    if (h > 99) h = 99;
     
     d[0] = div10[h];      /* miles */
     d[1] = mod10[h];      /* centenas */
     d[2] = div10[l];      /* decenas */
     d[3] = mod10[l];      /* unidades */
     
-    for (i = 4 - digits; i < 4; i++) {
-        ssd1306_bigchar(pos, page, '0' + d[i]);
-        pos += BIGFONT_CHAR_W + BIGFONT_SPACING;
+    if (digits > 4) digits = 4;
+    for (i = 0; i < digits; i++) {
+        str[i] = '0' + d[4 - digits + i];
+    }
+    str[digits] = '\0';
+    return digits;
+}
+
+/* Dibujar hora HH:MM en posición específica (usa tablas precalculadas) */
+void ssd1306_bignum_time(uint8_t x, uint8_t page, uint8_t hours, uint8_t minutes) {
+    char str[9];
+    
+    time_str(str, hours, minutes, 0xFF);
+    ssd1306_bigtext(x, page, str);
+}
+
+/* Dibujar hora HH:MM centrada (constantes precalculadas) */
+void ssd1306_bignum_time_centered(uint8_t hours, uint8_t minutes) {
+    /* HH:MM = 5 caracteres, ancho = 5*15 + 4*1 = 79px */
+    /* x = (WIDTH - 79) / 2 = 24 en 128 columnas (constante) */
+    ssd1306_bignum_time((SSD1306_WIDTH - 79) / 2, BIGFONT_CENTER, hours, minutes);
+}
+
+/* Dibujar número grande (0-9999) usando tablas */
+void ssd1306_bignum_number(uint8_t x, uint8_t page, uint16_t num, uint8_t digits) {
+    char str[5];
+    
+    number_str(str, num, digits);
+    ssd1306_bigtext(x, page, str);
+}
+
+/* Dibujar hora HH:MM:SS centrada */
+void ssd1306_bignum_time_full(uint8_t hours, uint8_t minutes, uint8_t seconds) {
+    char str[9];
+    
+    /* 8 caracteres: 8*15 + 7*1 = 127 px */
+    if (seconds > 99) seconds = 99;
+    time_str(str, hours, minutes, seconds);
+    ssd1306_bigtext((SSD1306_WIDTH - 127) / 2, BIGFONT_CENTER, str);
+}
+
+/* ============================================
+ * RELOJES Y CONTADORES CON ESTADO
+ * ============================================ */
+
+void ssd1306_bigfield_init(ssd1306_bigfield *f, uint8_t x, uint8_t page) {
+    f->x = x;
+    f->page = page;
+    f->len = 0;
+}
+
+void ssd1306_bigfield_invalidate(ssd1306_bigfield *f) {
+    f->len = 0;
+}
+
+/* Mostrar str: cada tramo de caracteres cambiados en una ventana */
+static void bigfield_show(ssd1306_bigfield *f, char *str, uint8_t len) {
+    uint8_t i, start;
+    char keep;
+    
+    /* Otro formato (o invalidado): redibujar todo */
+    if (len != f->len) {
+        for (i = 0; i < len; i++) {
+            f->last[i] = 0;
+        }
+        f->len = len;
     }
+    
+    i = 0;
+    while (i < len) {
+        if (str[i] == f->last[i]) {
+            i++;
+            continue;
+        }
+        start = i;
+        while (i < len && str[i] != f->last[i]) {
+            f->last[i] = str[i];
+            i++;
+        }
+        
+        /* Cortar la cadena al final del tramo y dibujarlo */
+        keep = str[i];
+        str[i] = '\0';
+        ssd1306_bigtext(f->x + start * (BIGFONT_CHAR_W + BIGFONT_SPACING), f->page, &str[start]);
+        str[i] = keep;
+    }
+}
+
+void ssd1306_bigfield_time(ssd1306_bigfield *f, uint8_t hours, uint8_t minutes) {
+    char str[9];
+    
+    bigfield_show(f, str, time_str(str, hours, minutes, 0xFF));
+}
+
+void ssd1306_bigfield_time_full(ssd1306_bigfield *f, uint8_t hours, uint8_t minutes, uint8_t seconds) {
+    char str[9];
+    
+    if (seconds > 99) seconds = 99;
+    bigfield_show(f, str, time_str(str, hours, minutes, seconds));
+}
+
+void ssd1306_bigfield_number(ssd1306_bigfield *f, uint16_t num, uint8_t digits) {
+    char str[5];
+    
+    bigfield_show(f, str, number_str(str, num, digits));
 }
 
 #endif /* SSD1306_USE_BIGNUM */
@@ -31,7 +31,7 @@
 /* Posiciones de fila (páginas SSD1306) */
 #define BIGFONT_ROW1      0       /* Fila superior: página 0 */
 #define BIGFONT_ROW2      2       /* Fila inferior: página 2 */
-#define BIGFONT_CENTER    1       /* Fila centrada: página 1 */
+#define BIGFONT_CENTER    ((SSD1306_PAGES - 2) / 2)   /* Fila centrada: página 1 en 32 px */
 
 /* ============================================
  * FUNCIONES DE TEXTO
@@ -71,6 +71,36 @@ void ssd1306_bignum_2digit(uint8_t x, uint8_t page, uint8_t num);
 /* Dibujar número grande (0-9999) */
 void ssd1306_bignum_number(uint8_t x, uint8_t page, uint16_t num, uint8_t digits);
 
+/* Dibujar hora HH:MM:SS centrada (8 caracteres = 127 px) */
+void ssd1306_bignum_time_full(uint8_t hours, uint8_t minutes, uint8_t seconds);
+
+/* ============================================
+ * RELOJES Y CONTADORES CON ESTADO
+ * ============================================
+ * Recuerdan lo mostrado y solo redibujan los caracteres que cambian
+ * (los contiguos en una sola ventana). Un reloj HH:MM suele cambiar
+ * un dígito por minuto: 1 carácter en vez de 5.
+ */
+typedef struct {
+    uint8_t x;          /* Posición del primer carácter */
+    uint8_t page;       /* Página superior */
+    uint8_t len;        /* Caracteres mostrados (0 = nada) */
+    char last[8];       /* Contenido mostrado */
+} ssd1306_bigfield;
+
+/* Preparar en (x, page); el primer set dibuja todo */
+void ssd1306_bigfield_init(ssd1306_bigfield *f, uint8_t x, uint8_t page);
+
+/* Forzar redibujo completo (p.ej. tras ssd1306_clear) */
+void ssd1306_bigfield_invalidate(ssd1306_bigfield *f);
+
+/* Reloj HH:MM / HH:MM:SS */
+void ssd1306_bigfield_time(ssd1306_bigfield *f, uint8_t hours, uint8_t minutes);
+void ssd1306_bigfield_time_full(ssd1306_bigfield *f, uint8_t hours, uint8_t minutes, uint8_t seconds);
+
+/* Contador de 1-4 dígitos (0-9999) con ceros a la izquierda */
+void ssd1306_bigfield_number(ssd1306_bigfield *f, uint16_t num, uint8_t digits);
+
 /* ============================================
  * UTILIDADES
  * ============================================ */
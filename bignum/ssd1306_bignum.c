@@ -11,9 +11,11 @@
 
 #include "ssd1306_bignum.h"
 #include "../core/ssd1306_core.h"
-#include "../../i2c/i2c.h"
+#if SSD1306_USE_TEXT
+#include "../text/ssd1306_text.h"
+#endif
 
-#if SSD1306_USE_BIGNUM
+#if SSD1306_USE_BIGNUM24
 
 /* ============================================
  * BLOQUES BASE 8x8
@@ -164,18 +166,100 @@ static const uint8_t digit_map[12][12] = {
     { 1, 1, 1,   1, 6, 1,   1, 6, 1,   1, 1, 1},
 };
 
-/* Dibujar un bloque 8x8 */
-static void draw_block(uint8_t x, uint8_t page, uint8_t block_id) {
-    uint8_t i;
+/* Ancho de una celda: dígito o dos puntos */
+#define CELL_W(c)   (((c) == ':') ? 8 : BIGNUM_WIDTH)
+
+/* Índice en digit_map de un carácter ('0'-'9', ':', '-') */
+static uint8_t cell_map(char c) {
+    if (c == ':') return 10;
+    if (c == '-') return 11;
+    if (c < '0' || c > '9') return 0;
+    return c - '0';
+}
+
+/*
+ * Enviar la fila 'row' (página) de una cadena de celdas: n bytes exactos,
+ * con BIGNUM_SPACING columnas vacías entre celdas. La ventana ya está
+ * abierta con ancho n; en direccionamiento horizontal cada página se
+ * rellena de izquierda a derecha antes de pasar a la siguiente.
+ */
+static void cells_row(const char *str, uint8_t row, uint8_t n) {
+    const uint8_t *map;
+    uint8_t col, k;
+    
+    while (n) {
+        map = digit_map[cell_map(*str)] + row * 3;
+        if (*str++ == ':') {
+            k = (n < 8) ? n : 8;
+            ssd1306_data_buf(blocks[map[1]], k);
+            n -= k;
+        } else {
+            for (col = 0; col < 3 && n; col++) {
+                k = (n < 8) ? n : 8;
+                ssd1306_data_buf(blocks[map[col]], k);
+                n -= k;
+            }
+        }
+        if (n) {
+            k = (n < BIGNUM_SPACING) ? n : BIGNUM_SPACING;
+            ssd1306_data_repeat(0x00, k);     /* Espacio entre celdas */
+            n -= k;
+        }
+    }
+}
+
+/*
+ * Dibujar len celdas de str desde x en una sola ventana de 4 páginas:
+ * un HH:MM completo es 1 transacción. Lo que pasa del borde se recorta.
+ */
+static void draw_cells(uint8_t x, const char *str, uint8_t len) {
+    uint16_t end = x;
+    uint8_t i, row;
+    
+    if (len == 0 || x >= SSD1306_WIDTH) return;
+    for (i = 0; i < len; i++) {
+        end += CELL_W(str[i]) + BIGNUM_SPACING;
+    }
+    end -= BIGNUM_SPACING + 1;      /* Última columna de la última celda */
+    if (end >= SSD1306_WIDTH) end = SSD1306_WIDTH - 1;
+    
+    ssd1306_window_begin(x, (uint8_t)end, 0, BIGNUM_HEIGHT - 1);
+    for (row = 0; row < BIGNUM_HEIGHT; row++) {
+        cells_row(str, row, (uint8_t)end - x + 1);
+    }
+    ssd1306_data_end();
+}
+
+/* Decenas y unidades de 0-99 sin dividir */
+static void split2(char *str, uint8_t num) {
+    uint8_t tens = 0;
     
-    ssd1306_set_pos(x, page);
+    if (num > 99) num = 99;
+    while (num >= 10) {
+        num -= 10;
+        tens++;
+    }
+    str[0] = '0' + tens;
+    str[1] = '0' + num;
+}
+
+/* Últimos digits (1-4) dígitos de num, restando potencias de 10 */
+static uint8_t number_str(char *str, uint16_t num, uint8_t digits) {
+    static const uint16_t pow10[4] = { 1000, 100, 10, 1 };
+    uint8_t i;
+    char c;
     
-    i2c_start(SSD1306_ADDR, I2C_WRITE);
-    i2c_write_byte(SSD1306_DATA);
-    for (i = 0; i < 8; i++) {
-        i2c_write_byte(blocks[block_id][i]);
+    if (digits > 4) digits = 4;
+    while (num >= 10000) num -= 10000;
+    for (i = 0; i < 4; i++) {
+        c = '0';
+        while (num >= pow10[i]) {
+            num -= pow10[i];
+            c++;
+        }
+        if (i >= 4 - digits) *str++ = c;
     }
-    i2c_stop();
+    return digits;
 }
 
 /* ============================================
@@ -183,74 +267,159 @@ static void draw_block(uint8_t x, uint8_t page, uint8_t block_id) {
  * ============================================ */
 
 /* Dibujar un dígito grande (0-9) */
-void ssd1306_bignum_digit(uint8_t x, uint8_t digit) {
-    uint8_t col, row;
-    uint8_t block_idx;
+void ssd1306_bignum24_digit(uint8_t x, uint8_t digit) {
+    char c;
     
     if (digit > 9) digit = 0;
-    
-    for (row = 0; row < 4; row++) {
-        for (col = 0; col < 3; col++) {
-            block_idx = digit_map[digit][row * 3 + col];
-            draw_block(x + col * 8, row, block_idx);
-        }
-    }
+    c = '0' + digit;
+    draw_cells(x, &c, 1);
 }
 
 /* Dibujar dos puntos ":" para reloj */
-void ssd1306_bignum_colon(uint8_t x) {
-    uint8_t row;
-    
-    for (row = 0; row < 4; row++) {
-        draw_block(x, row, digit_map[10][row * 3 + 1]);
-    }
+void ssd1306_bignum24_colon(uint8_t x) {
+    draw_cells(x, ":", 1);
 }
 
 /* Dibujar número de 2 dígitos (00-99) */
-void ssd1306_bignum_2digit(uint8_t x, uint8_t num) {
-    if (num > 99) num = 99;
+void ssd1306_bignum24_2digit(uint8_t x, uint8_t num) {
+    char str[2];
     
-    ssd1306_bignum_digit(x, num / 10);
-    ssd1306_bignum_digit(x + BIGNUM_WIDTH + BIGNUM_SPACING, num % 10);
+    split2(str, num);
+    draw_cells(x, str, 2);
+}
+
+/* Escribir "HH:MM" (y "ss" si seconds <= 99) en str. Retorna las celdas */
+static uint8_t time_str(char *str, uint8_t hours, uint8_t minutes, uint8_t seconds) {
+    split2(&str[0], hours);
+    str[2] = ':';
+    split2(&str[3], minutes);
+    if (seconds > 99) return 5;
+    split2(&str[5], seconds);
+    return 7;
 }
 
 /* Dibujar hora HH:MM */
-void ssd1306_bignum_time(uint8_t x, uint8_t hours, uint8_t minutes) {
-    uint8_t pos = x;
+void ssd1306_bignum24_time(uint8_t x, uint8_t hours, uint8_t minutes) {
+    char str[5];
     
-    /* Horas */
-    ssd1306_bignum_digit(pos, hours / 10);
-    pos += BIGNUM_WIDTH + BIGNUM_SPACING;
-    ssd1306_bignum_digit(pos, hours % 10);
-    pos += BIGNUM_WIDTH + BIGNUM_SPACING;
+    draw_cells(x, str, time_str(str, hours, minutes, 0xFF));
+}
+
+/* Dibujar número grande (0-9999) */
+void ssd1306_bignum24_number(uint8_t x, uint16_t num, uint8_t digits) {
+    char str[4];
     
-    /* Colon */
-    ssd1306_bignum_colon(pos);
-    pos += 8 + BIGNUM_SPACING;
+    draw_cells(x, str, number_str(str, num, digits));
+}
+
+/* ============================================
+ * HH:MM + SEGUNDOS PEQUEÑOS
+ * ============================================
+ * HH:MM ocupa 4*24 + 8 + 4*2 = 112 px; los segundos 5x7 van en la
+ * última página a partir de x + 116 (2 caracteres = 12 px: 116..127).
+ */
+#define BIGNUM_HHMM_W   (4 * BIGNUM_WIDTH + 8 + 4 * BIGNUM_SPACING)
+#define BIGNUM_SEC_X    (BIGNUM_HHMM_W + 4)
+#define BIGNUM_SEC_PAGE (BIGNUM_HEIGHT - 1)
+
+#if SSD1306_USE_TEXT
+void ssd1306_bignum24_time_full(uint8_t x, uint8_t hours, uint8_t minutes, uint8_t seconds) {
+    char str[8];
     
-    /* Minutos */
-    ssd1306_bignum_digit(pos, minutes / 10);
-    pos += BIGNUM_WIDTH + BIGNUM_SPACING;
-    ssd1306_bignum_digit(pos, minutes % 10);
+    if (seconds > 99) seconds = 99;
+    time_str(str, hours, minutes, seconds);
+    str[7] = '\0';
+    draw_cells(x, str, 5);
+    ssd1306_text(x + BIGNUM_SEC_X, BIGNUM_SEC_PAGE, &str[5]);
 }
+#endif
 
-/* Dibujar número grande (0-9999) */
-void ssd1306_bignum_number(uint8_t x, uint16_t num, uint8_t digits) {
-    uint8_t i;
-    uint8_t d[4];
-    uint8_t pos = x;
+/* ============================================
+ * RELOJES Y CONTADORES CON ESTADO
+ * ============================================ */
+
+void ssd1306_bigfield24_init(ssd1306_bigfield24 *f, uint8_t x) {
+    f->x = x;
+    f->len = 0;
+}
+
+void ssd1306_bigfield24_invalidate(ssd1306_bigfield24 *f) {
+    f->len = 0;
+}
+
+/*
+ * Mostrar str (len celdas) y redibujar solo las cambiadas: cada tramo
+ * contiguo en una ventana. Las celdas desde 'small' (segundos del reloj)
+ * van en 5x7 en la última página.
+ */
+static void bigfield_show(ssd1306_bigfield24 *f, char *str, uint8_t len, uint8_t small) {
+    uint8_t i, start;
+    uint8_t pos = f->x;
+    uint8_t start_pos;
     
-    /* Extraer dígitos */
-    d[0] = (num / 1000) % 10;
-    d[1] = (num / 100) % 10;
-    d[2] = (num / 10) % 10;
-    d[3] = num % 10;
+    /* Otro formato (o invalidado): redibujar todo */
+    if (len != f->len) {
+        for (i = 0; i < len; i++) {
+            f->last[i] = 0;
+        }
+        f->len = len;
+    }
     
-    /* Dibujar según cantidad de dígitos solicitados */
-    for (i = 4 - digits; i < 4; i++) {
-        ssd1306_bignum_digit(pos, d[i]);
-        pos += BIGNUM_WIDTH + BIGNUM_SPACING;
+    /* Celdas grandes */
+    i = 0;
+    while (i < small) {
+        if (str[i] == f->last[i]) {
+            pos += CELL_W(str[i]) + BIGNUM_SPACING;
+            i++;
+            continue;
+        }
+        start = i;
+        start_pos = pos;
+        while (i < small && str[i] != f->last[i]) {
+            f->last[i] = str[i];
+            pos += CELL_W(str[i]) + BIGNUM_SPACING;
+            i++;
+        }
+        draw_cells(start_pos, &str[start], i - start);
     }
+    
+#if SSD1306_USE_TEXT
+    /* Segundos 5x7 (de la celda que cambia al final) */
+    for (i = small; i < len; i++) {
+        if (str[i] != f->last[i]) break;
+    }
+    if (i < len) {
+        start = i;
+        for (; i < len; i++) {
+            f->last[i] = str[i];
+        }
+        str[len] = '\0';
+        ssd1306_text(f->x + BIGNUM_SEC_X + (start - small) * 6, BIGNUM_SEC_PAGE, &str[start]);
+    }
+#endif
+}
+
+void ssd1306_bigfield24_time(ssd1306_bigfield24 *f, uint8_t hours, uint8_t minutes) {
+    char str[5];
+    
+    bigfield_show(f, str, time_str(str, hours, minutes, 0xFF), 5);
+}
+
+#if SSD1306_USE_TEXT
+void ssd1306_bigfield24_time_full(ssd1306_bigfield24 *f, uint8_t hours, uint8_t minutes, uint8_t seconds) {
+    char str[8];
+    
+    if (seconds > 99) seconds = 99;
+    bigfield_show(f, str, time_str(str, hours, minutes, seconds), 5);
+}
+#endif
+
+void ssd1306_bigfield24_number(ssd1306_bigfield24 *f, uint16_t num, uint8_t digits) {
+    char str[4];
+    
+    if (digits == 0) return;
+    digits = number_str(str, num, digits);
+    bigfield_show(f, str, digits, digits);
 }
 
-#endif /* SSD1306_USE_BIGNUM */
+#endif /* SSD1306_USE_BIGNUM24 */
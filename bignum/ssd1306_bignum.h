@@ -3,6 +3,9 @@
  * 
  * Dígitos de 24x32 píxeles (3 cols × 4 páginas)
  * Ideal para relojes y contadores
+ *
+ * Prefijo propio (ssd1306_bignum24_*, ssd1306_bigfield24) para poder
+ * enlazarse junto a BigFont 15x15 (ssd1306_bigfont.c).
  */
 
 #ifndef SSD1306_BIGNUM_H
@@ -11,7 +14,7 @@
 #include <stdint.h>
 #include <ssd1306/ssd1306_config.h>
 
-#if SSD1306_USE_BIGNUM
+#if SSD1306_USE_BIGNUM24
 
 /* Dimensiones de dígitos grandes */
 #define BIGNUM_WIDTH    24      /* 3 bloques de 8 píxeles */
@@ -19,20 +22,64 @@
 #define BIGNUM_SPACING  2       /* Espacio entre dígitos */
 
 /* Dibujar un dígito grande (0-9) */
-void ssd1306_bignum_digit(uint8_t x, uint8_t digit);
+void ssd1306_bignum24_digit(uint8_t x, uint8_t digit);
 
 /* Dibujar dos puntos ":" para reloj */
-void ssd1306_bignum_colon(uint8_t x);
+void ssd1306_bignum24_colon(uint8_t x);
 
 /* Dibujar número de 2 dígitos (00-99) */
-void ssd1306_bignum_2digit(uint8_t x, uint8_t num);
+void ssd1306_bignum24_2digit(uint8_t x, uint8_t num);
 
 /* Dibujar hora HH:MM */
-void ssd1306_bignum_time(uint8_t x, uint8_t hours, uint8_t minutes);
+void ssd1306_bignum24_time(uint8_t x, uint8_t hours, uint8_t minutes);
 
 /* Dibujar número grande (0-9999) */
-void ssd1306_bignum_number(uint8_t x, uint16_t num, uint8_t digits);
+void ssd1306_bignum24_number(uint8_t x, uint16_t num, uint8_t digits);
 
-#endif /* SSD1306_USE_BIGNUM */
+#if SSD1306_USE_TEXT
+/* Dibujar hora HH:MM con segundos 5x7 abajo a la derecha (128 px desde x = 0).
+ * HH:MM:SS a 24x32 serían 174 px: los segundos van en la fuente pequeña. */
+void ssd1306_bignum24_time_full(uint8_t x, uint8_t hours, uint8_t minutes, uint8_t seconds);
+#endif
+
+/* ============================================
+ * RELOJES Y CONTADORES CON ESTADO
+ * ============================================
+ * Recuerdan lo mostrado y solo redibujan los dígitos que cambian:
+ * un reloj HH:MM envía 1 dígito por minuto en vez de 5 celdas.
+ */
+typedef struct {
+    uint8_t x;          /* Posición del primer dígito */
+    uint8_t len;        /* Celdas mostradas (0 = nada) */
+    char last[7];       /* Celdas mostradas ("HH:MMss") */
+} ssd1306_bigfield24;
+
+/* Preparar en x; el primer set dibuja todo */
+void ssd1306_bigfield24_init(ssd1306_bigfield24 *f, uint8_t x);
+
+/* Forzar redibujo completo (p.ej. tras ssd1306_clear) */
+void ssd1306_bigfield24_invalidate(ssd1306_bigfield24 *f);
+
+/* Reloj HH:MM */
+void ssd1306_bigfield24_time(ssd1306_bigfield24 *f, uint8_t hours, uint8_t minutes);
+
+#if SSD1306_USE_TEXT
+/* Reloj HH:MM + segundos 5x7 (mismo diseño que ssd1306_bignum24_time_full) */
+void ssd1306_bigfield24_time_full(ssd1306_bigfield24 *f, uint8_t hours, uint8_t minutes, uint8_t seconds);
+#endif
+
+/* Contador de 1-4 dígitos (0-9999) con ceros a la izquierda */
+void ssd1306_bigfield24_number(ssd1306_bigfield24 *f, uint16_t num, uint8_t digits);
+
+/* Nombres anteriores (sin el 24), solo si BigFont 15x15 no está activo */
+#if !SSD1306_USE_BIGNUM
+#define ssd1306_bignum_digit    ssd1306_bignum24_digit
+#define ssd1306_bignum_colon    ssd1306_bignum24_colon
+#define ssd1306_bignum_2digit   ssd1306_bignum24_2digit
+#define ssd1306_bignum_time     ssd1306_bignum24_time
+#define ssd1306_bignum_number   ssd1306_bignum24_number
+#endif
+
+#endif /* SSD1306_USE_BIGNUM24 */
 
 #endif /* SSD1306_BIGNUM_H */
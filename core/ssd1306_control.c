@@ -9,8 +9,11 @@
 
 /* Ajustar contraste */
 void ssd1306_set_contrast(uint8_t contrast) {
-    ssd1306_cmd(0x81);
-    ssd1306_cmd(contrast);
+    uint8_t cmds[2];
+    
+    cmds[0] = 0x81;
+    cmds[1] = contrast;
+    ssd1306_cmd_list(cmds, 2);
 }
 
 /* Invertir colores */
@@ -5,88 +5,355 @@
  */
 
 #include "ssd1306_core.h"
-#include "../../i2c/i2c.h"
+#include "../transport/ssd1306_transport.h"
+
+/* ============================================
+ * ACCESO AL BUS
+ * Todo el tráfico de la librería pasa por estas macros, que envuelven
+ * la capa de transporte. Con SSD1306_USE_STATS=0 son las operaciones
+ * del transporte sin más.
+ * ============================================ */
+
+#if SSD1306_USE_STATS
+static ssd1306_stats stats;
+static ssd1306_tick_fn tick_fn = 0;
+static uint16_t tick_start;
+
+static void stat_begin(void) {
+    stats.starts++;
+    stats.bytes += SSD1306_T_ADDR_BYTES;
+    if (tick_fn) tick_start = tick_fn();
+}
+
+static void stat_end(void) {
+    if (tick_fn) stats.ticks += (uint16_t)(tick_fn() - tick_start);
+}
+
+#define STAT_BEGIN()    stat_begin()
+#define STAT_END()      stat_end()
+#define STAT_BYTES(n)   (stats.bytes += (n))
+#define STAT_CMDS(n)    (stats.cmds += (n))
+
+const ssd1306_stats* ssd1306_get_stats(void) {
+    return &stats;
+}
+
+void ssd1306_reset_stats(void) {
+    stats.bytes = 0;
+    stats.starts = 0;
+    stats.cmds = 0;
+    stats.flushes = 0;
+    stats.ticks = 0;
+}
+
+void ssd1306_set_tick(ssd1306_tick_fn fn) {
+    tick_fn = fn;
+}
+
+void ssd1306_stat_flush(void) {
+    stats.flushes++;
+}
+#else
+#define STAT_BEGIN()
+#define STAT_END()
+#define STAT_BYTES(n)
+#define STAT_CMDS(n)
+#endif
+
+#define BUS_BEGIN()         do { STAT_BEGIN(); SSD1306_T_BEGIN(); } while (0)
+#define BUS_BEGIN_CMD()     do { STAT_BEGIN(); STAT_BYTES(SSD1306_T_MODE_BYTES); SSD1306_T_BEGIN_CMD(); } while (0)
+#define BUS_CMD(c)          do { STAT_CMDS(1); STAT_BYTES(SSD1306_T_CMD_BYTES); SSD1306_T_CMD(c); } while (0)
+#define BUS_DATA()          do { STAT_BYTES(SSD1306_T_MODE_BYTES); SSD1306_T_DATA(); } while (0)
+#define BUS_WRITE(b)        do { STAT_BYTES(1); SSD1306_T_WRITE(b); } while (0)
+#define BUS_END()           do { SSD1306_T_END(); STAT_END(); } while (0)
 
 /* ============================================
  * FUNCIONES INTERNAS
  * ============================================ */
 
+/* Enviar lista de comandos en una sola transacción */
+void ssd1306_cmd_list(const uint8_t *cmds, uint8_t n) {
+    BUS_BEGIN_CMD();
+    STAT_BYTES(n);
+    STAT_CMDS(n);
+    ssd1306_t_write_buf(cmds, n);
+    BUS_END();
+}
+
 /* Enviar comando */
 void ssd1306_cmd(uint8_t cmd) {
-    i2c_start(SSD1306_ADDR, I2C_WRITE);
-    i2c_write_byte(SSD1306_CMD);
-    i2c_write_byte(cmd);
-    i2c_stop();
+    ssd1306_cmd_list(&cmd, 1);
 }
 
-/* Posicionar cursor */
+/* ============================================
+ * DISPLAY SELECCIONADO (SSD1306_USE_MULTI)
+ * ============================================ */
+#if SSD1306_USE_MULTI
+#if SSD1306_USE_FRAMEBUFFER
+#define DEFAULT_FB      ssd1306_fb_default
+#else
+#define DEFAULT_FB      0
+#endif
+
+ssd1306_dev ssd1306_default = { SSD1306_ADDR, SSD1306_WIDTH, SSD1306_PAGES, 0, 0, DEFAULT_FB,
+                                  SSD1306_DIRTY_CLEAN, { 0 } };
+ssd1306_dev *ssd1306_cur = &ssd1306_default;
+
+void ssd1306_dev_setup(ssd1306_dev *dev, uint8_t addr, uint8_t *fb) {
+    uint8_t page;
+    
+    dev->addr = addr;
+    dev->width = SSD1306_WIDTH;
+    dev->pages = SSD1306_PAGES;
+    dev->window_narrow = 0;
+    dev->display_pending = 0;
+#if SSD1306_USE_FRAMEBUFFER
+    if (!fb && dev == &ssd1306_default) fb = ssd1306_fb_default;
+#endif
+    dev->fb = fb;
+    for (page = 0; page < SSD1306_PAGES; page++) {
+        dev->dirty_x0[page] = 0xFF;
+        dev->dirty_x1[page] = 0;
+    }
+}
+
+void ssd1306_select(ssd1306_dev *dev) {
+    ssd1306_cur = dev;
+#if SSD1306_TRANSPORT != SSD1306_TRANSPORT_SPI
+    ssd1306_t_addr = dev->addr;
+#endif
+}
+
+/* El estado de direccionamiento es el del display seleccionado */
+#define window_narrow       (ssd1306_cur->window_narrow)
+#define display_pending     (ssd1306_cur->display_pending)
+#endif /* SSD1306_USE_MULTI */
+
+/*
+ * Ventana de direccionamiento (0x21/0x22).
+ * En modo horizontal la ventana limita dónde "da la vuelta" el puntero.
+ * Si queda reducida, el siguiente set_pos/data_begin la restaura a
+ * pantalla completa para que el texto no se enrolle dentro de ella.
+ */
+#if !SSD1306_USE_MULTI
+static uint8_t window_narrow = 0;
+#endif
+
+/* Enviar ventana dentro de una transacción mixta y recordar si es reducida */
+static void co_window(uint8_t col0, uint8_t col1, uint8_t page0, uint8_t page1) {
+    BUS_CMD(0x21);
+    BUS_CMD(col0 + SSD1306_COL_OFFSET);
+    BUS_CMD(col1 + SSD1306_COL_OFFSET);
+    BUS_CMD(0x22);
+    BUS_CMD(page0);
+    BUS_CMD(page1);
+    window_narrow = (col0 != 0 || col1 != SSD1306_WIDTH - 1 ||
+                     page0 != 0 || page1 != SSD1306_PAGES - 1);
+}
+
+/* Posicionar cursor (1 transacción en vez de 3) */
 void ssd1306_set_pos(uint8_t col, uint8_t page) {
-    ssd1306_cmd(0xB0 + page);
-    ssd1306_cmd(0x00 + (col & 0x0F));
-    ssd1306_cmd(0x10 + ((col >> 4) & 0x0F));
+    uint8_t cmds[9];
+    uint8_t n = 0;
+    
+    if (window_narrow) {
+        cmds[0] = 0x21;
+        cmds[1] = SSD1306_COL_OFFSET;
+        cmds[2] = SSD1306_COL_OFFSET + SSD1306_WIDTH - 1;
+        cmds[3] = 0x22; cmds[4] = 0; cmds[5] = SSD1306_PAGES - 1;
+        n = 6;
+        window_narrow = 0;
+    }
+    col += SSD1306_COL_OFFSET;
+    cmds[n++] = 0xB0 + page;
+    cmds[n++] = 0x00 + (col & 0x0F);
+    cmds[n++] = 0x10 + ((col >> 4) & 0x0F);
+    ssd1306_cmd_list(cmds, n);
+}
+
+/* Definir ventana de columnas/páginas (1 transacción) */
+void ssd1306_set_window(uint8_t col0, uint8_t col1, uint8_t page0, uint8_t page1) {
+    BUS_BEGIN();
+    co_window(col0, col1, page0, page1);
+    BUS_END();
+}
+
+/*
+ * Escritura posicionada en una sola transacción:
+ *   START, addr, 0x80 B0+page, 0x80 col_lo, 0x80 col_hi, 0x40 datos..., STOP
+ * Cada comando va precedido de un byte de control con Co=1 (0x80);
+ * el byte 0x40 (Co=0, D/C=1) indica que el resto son datos.
+ */
+void ssd1306_data_begin(uint8_t col, uint8_t page) {
+    BUS_BEGIN();
+    if (window_narrow) {
+        co_window(0, SSD1306_WIDTH - 1, 0, SSD1306_PAGES - 1);
+    }
+    col += SSD1306_COL_OFFSET;
+    BUS_CMD(0xB0 + page);
+    BUS_CMD(0x00 + (col & 0x0F));
+    BUS_CMD(0x10 + ((col >> 4) & 0x0F));
+    BUS_DATA();
+}
+
+/* Iniciar escritura en ventana: ventana + datos en 1 transacción.
+ * Los datos recorren la ventana fila de páginas a fila (modo horizontal). */
+void ssd1306_window_begin(uint8_t col0, uint8_t col1, uint8_t page0, uint8_t page1) {
+    BUS_BEGIN();
+    co_window(col0, col1, page0, page1);
+    BUS_DATA();
+}
+
+/* Enviar un byte de datos (entre data_begin y data_end) */
+void ssd1306_data_put(uint8_t data) {
+    BUS_WRITE(data);
+}
+
+/* Enviar un bloque de datos (entre data_begin y data_end) */
+void ssd1306_data_buf(const uint8_t *data, uint8_t n) {
+    STAT_BYTES(n);
+    ssd1306_t_write_buf(data, n);
+}
+
+/* Enviar n veces el mismo byte (entre data_begin y data_end) */
+void ssd1306_data_repeat(uint8_t value, uint8_t n) {
+    STAT_BYTES(n);
+    ssd1306_t_write_repeat(value, n);
+}
+
+/* Cerrar transacción de datos */
+void ssd1306_data_end(void) {
+    BUS_END();
+}
+
+/* Escribir un bloque de datos en (col, page) con 1 transacción */
+void ssd1306_write_at(uint8_t col, uint8_t page, const uint8_t *data, uint8_t len) {
+    ssd1306_data_begin(col, page);
+    STAT_BYTES(len);
+    ssd1306_t_write_buf(data, len);
+    BUS_END();
+}
+
+/* Escribir un rectángulo (w x pages) en 1 transacción usando una ventana */
+void ssd1306_write_window(uint8_t col, uint8_t page, uint8_t w, uint8_t pages, const uint8_t *data) {
+    ssd1306_window_begin(col, col + w - 1, page, page + pages - 1);
+    while (pages--) {
+        STAT_BYTES(w);
+        ssd1306_t_write_buf(data, w);
+        data += w;
+    }
+    BUS_END();
 }
 
 /* ============================================
  * FUNCIONES PÚBLICAS
  * ============================================ */
 
-/* Inicializar display 128x32 */
-uint8_t ssd1306_init(void) {
+/* Secuencia de inicialización (perfil de panel en ssd1306_config.h) */
+static const uint8_t init_seq[] = {
+    0xAE,       /* Display off */
+    0xD5, 0x80, /* Set clock div */
+    0xA8, SSD1306_MUX,      /* Set multiplex: HEIGHT líneas */
+    0xD3, 0x00, /* Set display offset */
+    0x40,       /* Set start line */
+    0x8D, 0x14, /* Charge pump */
+    0x20, 0x00, /* Memory mode: horizontal */
+    0x21, SSD1306_COL_OFFSET, SSD1306_COL_OFFSET + SSD1306_WIDTH - 1,  /* Ventana completa */
+    0x22, 0x00, SSD1306_PAGES - 1,
+    0xA1,       /* Seg remap */
+    0xC8,       /* COM scan dec */
+    0xDA, SSD1306_COMPINS,  /* Set COM pins: 0x02 hasta 32 líneas, 0x12 más */
+    0x81, 0x8F, /* Set contrast */
+    0xD9, 0xF1, /* Set precharge */
+    0xDB, 0x40, /* Set VCOMH */
+    0xA4,       /* Display RAM */
+    0xA6,       /* Normal display */
+    0xAF        /* Display on (siempre el último) */
+};
+
+#if SSD1306_USE_INIT_EX
+/* Arranque en caliente: el panel conserva su configuración y su GDDRAM */
+static const uint8_t warm_seq[] = {
+    0x20, 0x00, /* Memory mode: horizontal */
+    0x21, SSD1306_COL_OFFSET, SSD1306_COL_OFFSET + SSD1306_WIDTH - 1,  /* Ventana completa */
+    0x22, 0x00, SSD1306_PAGES - 1,
+    0xAF        /* Display on (siempre el último) */
+};
+
+/* 1 = encender en el próximo flush (SSD1306_INIT_DEFER_ON) */
+#if !SSD1306_USE_MULTI
+static uint8_t display_pending = 0;
+#endif
+
+uint8_t ssd1306_init_ex(uint8_t flags) {
+    uint8_t ack;
+    uint8_t defer = (flags & SSD1306_INIT_DEFER_ON) ? 1 : 0;
+    
     /* Verificar que responde */
-    if (!i2c_start(SSD1306_ADDR, I2C_WRITE)) {
-        i2c_stop();
-        return 0;
+    STAT_BEGIN();
+    ack = SSD1306_T_PROBE();
+    STAT_END();
+    if (!ack) return 0;
+    
+    /* Con DEFER_ON se omite el 0xAF final */
+    if (flags & SSD1306_INIT_WARM) {
+        ssd1306_cmd_list(warm_seq, sizeof(warm_seq) - defer);
+    } else {
+        ssd1306_cmd_list(init_seq, sizeof(init_seq) - defer);
     }
-    i2c_stop();
+    window_narrow = 0;
+    display_pending = defer;
+    
+    return 1;
+}
+
+/* Llamado al terminar cada flush del framebuffer */
+void ssd1306_flush_done(void) {
+    if (display_pending) {
+        ssd1306_display_on();
+    }
+}
+
+/* Inicializar display */
+uint8_t ssd1306_init(void) {
+    return ssd1306_init_ex(0);
+}
+#else
+/* Inicializar display */
+uint8_t ssd1306_init(void) {
+    uint8_t ack;
+    
+    /* Verificar que responde */
+    STAT_BEGIN();
+    ack = SSD1306_T_PROBE();
+    STAT_END();
+    if (!ack) return 0;
     
-    /* Secuencia de inicialización para 128x32 */
-    ssd1306_cmd(0xAE); /* Display off */
-    ssd1306_cmd(0xD5); /* Set clock div */
-    ssd1306_cmd(0x80);
-    ssd1306_cmd(0xA8); /* Set multiplex */
-    ssd1306_cmd(0x1F); /* 32 líneas */
-    ssd1306_cmd(0xD3); /* Set display offset */
-    ssd1306_cmd(0x00);
-    ssd1306_cmd(0x40); /* Set start line */
-    ssd1306_cmd(0x8D); /* Charge pump */
-    ssd1306_cmd(0x14);
-    ssd1306_cmd(0x20); /* Memory mode */
-    ssd1306_cmd(0x00); /* Horizontal */
-    ssd1306_cmd(0xA1); /* Seg remap */
-    ssd1306_cmd(0xC8); /* COM scan dec */
-    ssd1306_cmd(0xDA); /* Set COM pins */
-    ssd1306_cmd(0x02);
-    ssd1306_cmd(0x81); /* Set contrast */
-    ssd1306_cmd(0x8F);
-    ssd1306_cmd(0xD9); /* Set precharge */
-    ssd1306_cmd(0xF1);
-    ssd1306_cmd(0xDB); /* Set VCOMH */
-    ssd1306_cmd(0x40);
-    ssd1306_cmd(0xA4); /* Display RAM */
-    ssd1306_cmd(0xA6); /* Normal display */
-    ssd1306_cmd(0xAF); /* Display on */
+    /* Secuencia de inicialización del panel (1 transacción) */
+    ssd1306_cmd_list(init_seq, sizeof(init_seq));
+    window_narrow = 0;
     
     return 1;
 }
+#endif /* SSD1306_USE_INIT_EX */
 
-/* Limpiar pantalla */
+/* Limpiar pantalla: ventana completa + 512 bytes en 1 transacción */
 void ssd1306_clear(void) {
-    uint8_t page, col;
+    uint8_t page;
     
+    ssd1306_window_begin(0, SSD1306_WIDTH - 1, 0, SSD1306_PAGES - 1);
     for (page = 0; page < SSD1306_PAGES; page++) {
-        ssd1306_set_pos(0, page);
-        
-        i2c_start(SSD1306_ADDR, I2C_WRITE);
-        i2c_write_byte(SSD1306_DATA);
-        for (col = 0; col < SSD1306_WIDTH; col++) {
-            i2c_write_byte(0x00);
-        }
-        i2c_stop();
+        STAT_BYTES(SSD1306_WIDTH);
+        ssd1306_t_write_repeat(0x00, SSD1306_WIDTH);
     }
+    BUS_END();
 }
 
 /* Encender display */
 void ssd1306_display_on(void) {
+#if SSD1306_USE_INIT_EX
+    display_pending = 0;
+#endif
     ssd1306_cmd(0xAF);
 }
 
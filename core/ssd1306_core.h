@@ -10,10 +10,6 @@
 #include <stdint.h>
 #include <ssd1306/ssd1306_config.h>
 
-/* Comandos SSD1306 */
-#define SSD1306_CMD         0x00
-#define SSD1306_DATA        0x40
-
 /* ============================================
  * FUNCIONES INTERNAS (usadas por otros módulos)
  * ============================================ */
@@ -21,16 +17,157 @@
 /* Enviar comando al display */
 void ssd1306_cmd(uint8_t cmd);
 
-/* Posicionar cursor (col 0-127, page 0-3) */
+/* Enviar n comandos en una sola transacción (un solo byte de control 0x00) */
+void ssd1306_cmd_list(const uint8_t *cmds, uint8_t n);
+
+/* Posicionar cursor (col 0..WIDTH-1, page 0..PAGES-1) */
 void ssd1306_set_pos(uint8_t col, uint8_t page);
 
+/* Escritura posicionada (posición + datos en 1 transacción):
+ *   ssd1306_data_begin(col, page);
+ *   ssd1306_data_put(byte); ...
+ *   ssd1306_data_end();
+ */
+void ssd1306_data_begin(uint8_t col, uint8_t page);
+void ssd1306_data_put(uint8_t data);
+void ssd1306_data_end(void);
+
+/* Enviar n bytes de un buffer / n veces un byte (entre data_begin y data_end) */
+void ssd1306_data_buf(const uint8_t *data, uint8_t n);
+void ssd1306_data_repeat(uint8_t value, uint8_t n);
+
+/* Escribir len bytes en (col, page) con 1 transacción */
+void ssd1306_write_at(uint8_t col, uint8_t page, const uint8_t *data, uint8_t len);
+
+/* Escribir un rectángulo de w columnas x pages páginas en 1 transacción.
+ * data: pages filas de w bytes, de arriba a abajo */
+void ssd1306_write_window(uint8_t col, uint8_t page, uint8_t w, uint8_t pages, const uint8_t *data);
+
+/* Definir ventana de escritura (comandos 0x21/0x22, modo horizontal) */
+void ssd1306_set_window(uint8_t col0, uint8_t col1, uint8_t page0, uint8_t page1);
+
+/* Iniciar escritura en ventana (ventana + datos en 1 transacción).
+ * Continuar con ssd1306_data_put() y cerrar con ssd1306_data_end(). */
+void ssd1306_window_begin(uint8_t col0, uint8_t col1, uint8_t page0, uint8_t page1);
+
+/* Inicializador de dirty_x0[] con todas las páginas limpias (x0 = 0xFF),
+ * el mismo estado que deja ssd1306_dev_setup() */
+#if SSD1306_PAGES == 1
+#define SSD1306_DIRTY_CLEAN { 0xFF }
+#elif SSD1306_PAGES == 2
+#define SSD1306_DIRTY_CLEAN { 0xFF, 0xFF }
+#elif SSD1306_PAGES == 3
+#define SSD1306_DIRTY_CLEAN { 0xFF, 0xFF, 0xFF }
+#elif SSD1306_PAGES == 4
+#define SSD1306_DIRTY_CLEAN { 0xFF, 0xFF, 0xFF, 0xFF }
+#elif SSD1306_PAGES == 5
+#define SSD1306_DIRTY_CLEAN { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF }
+#elif SSD1306_PAGES == 6
+#define SSD1306_DIRTY_CLEAN { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF }
+#elif SSD1306_PAGES == 7
+#define SSD1306_DIRTY_CLEAN { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF }
+#elif SSD1306_PAGES == 8
+#define SSD1306_DIRTY_CLEAN { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF }
+#endif
+
+/* ============================================
+ * VARIOS DISPLAYS (SSD1306_USE_MULTI)
+ * ============================================
+ * Cada display tiene su dirección, su estado de direccionamiento y su
+ * framebuffer. Todas las funciones actúan sobre el display
+ * seleccionado (ssd1306_cur); sin seleccionar nada es ssd1306_default
+ * en SSD1306_ADDR, así que la API de siempre no cambia.
+ * Todos los displays comparten el perfil compilado (SSD1306_PANEL).
+ */
+#if SSD1306_USE_MULTI
+typedef struct {
+    uint8_t addr;               /* Dirección I2C */
+    uint8_t width;              /* Geometría (= SSD1306_WIDTH / SSD1306_PAGES) */
+    uint8_t pages;
+    uint8_t window_narrow;      /* Ventana 0x21/0x22 reducida */
+    uint8_t display_pending;    /* Encender en el próximo flush (INIT_EX) */
+    uint8_t *fb;                /* Framebuffer WIDTH*PAGES bytes (NULL = sin él) */
+    uint8_t dirty_x0[SSD1306_PAGES];    /* Regiones sucias (FB_DIRTY) */
+    uint8_t dirty_x1[SSD1306_PAGES];
+} ssd1306_dev;
+
+extern ssd1306_dev ssd1306_default;
+extern ssd1306_dev *ssd1306_cur;
+
+#if SSD1306_USE_FRAMEBUFFER
+/* Framebuffer de ssd1306_default (definido en el módulo framebuffer) */
+extern uint8_t ssd1306_fb_default[];
+#endif
+
+/* Preparar un handle. fb: buffer de SSD1306_WIDTH*SSD1306_PAGES bytes, o NULL
+ * si el display no usa framebuffer (ssd1306_default recupera el suyo) */
+void ssd1306_dev_setup(ssd1306_dev *dev, uint8_t addr, uint8_t *fb);
+
+/* Seleccionar el display sobre el que actúan las funciones */
+void ssd1306_select(ssd1306_dev *dev);
+
+/* Variantes con handle: seleccionar y llamar */
+#define ssd1306_dev_init(dev)               (ssd1306_select(dev), ssd1306_init())
+#define ssd1306_dev_clear(dev)              (ssd1306_select(dev), ssd1306_clear())
+#define ssd1306_dev_display_on(dev)         (ssd1306_select(dev), ssd1306_display_on())
+#define ssd1306_dev_display_off(dev)        (ssd1306_select(dev), ssd1306_display_off())
+#define ssd1306_dev_set_pos(dev, c, p)      (ssd1306_select(dev), ssd1306_set_pos(c, p))
+#define ssd1306_dev_write_window(dev, c, p, w, n, d) \
+    (ssd1306_select(dev), ssd1306_write_window(c, p, w, n, d))
+#endif /* SSD1306_USE_MULTI */
+
+/* ============================================
+ * ESTADÍSTICAS (SSD1306_USE_STATS)
+ * ============================================ */
+
+#if SSD1306_USE_STATS
+/* Contadores acumulados desde el último ssd1306_reset_stats() */
+typedef struct {
+    uint32_t bytes;     /* Bytes en el bus, incluida la dirección */
+    uint16_t starts;    /* Transacciones I2C (START ... STOP) */
+    uint16_t cmds;      /* Bytes de comando enviados al controlador */
+    uint16_t flushes;   /* fb_flush / fb_flush_dirty / fb_flush_begin */
+    uint32_t ticks;     /* Tiempo dentro de transacciones (ver ssd1306_set_tick) */
+} ssd1306_stats;
+
+/* Reloj del usuario (timer libre de 16 bits) */
+typedef uint16_t (*ssd1306_tick_fn)(void);
+
+const ssd1306_stats* ssd1306_get_stats(void);
+void ssd1306_reset_stats(void);
+
+/* Opcional: medir tiempo de bus. NULL = no medir */
+void ssd1306_set_tick(ssd1306_tick_fn fn);
+
+/* Usado por el framebuffer para contar flushes */
+void ssd1306_stat_flush(void);
+#define SSD1306_STAT_FLUSH()    ssd1306_stat_flush()
+#else
+#define SSD1306_STAT_FLUSH()
+#endif
+
 /* ============================================
  * FUNCIONES PÚBLICAS
  * ============================================ */
 
-/* Inicializar display 128x32 */
+/* Inicializar display (según SSD1306_PANEL) */
 uint8_t ssd1306_init(void);
 
+#if SSD1306_USE_INIT_EX
+/* Flags de ssd1306_init_ex() */
+#define SSD1306_INIT_WARM       0x01    /* Panel ya configurado: solo modo, ventana y on */
+#define SSD1306_INIT_DEFER_ON   0x02    /* No encender hasta el primer flush del framebuffer */
+
+/* Inicializar con opciones (1=OK, 0=error). init_ex(0) == init() */
+uint8_t ssd1306_init_ex(uint8_t flags);
+
+/* Usado por el framebuffer: enciende el display si quedó pendiente */
+void ssd1306_flush_done(void);
+#define SSD1306_FLUSH_DONE()    ssd1306_flush_done()
+#else
+#define SSD1306_FLUSH_DONE()
+#endif
+
 /* Limpiar pantalla completa */
 void ssd1306_clear(void);
 
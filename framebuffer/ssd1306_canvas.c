@@ -0,0 +1,294 @@
+/**
+ * ssd1306_canvas.c - Lienzo virtual sobre varios paneles
+ *
+ * Cada píxel se traduce a (panel, x, y locales), se selecciona el panel
+ * y se usa la primitiva fb_* de siempre: el buffer y las regiones sucias
+ * son las de cada panel, y cv_flush() reparte el envío por dirección.
+ *
+ * Las funciones públicas guardan ssd1306_cur al entrar y lo restauran al
+ * salir; por dentro se usan las versiones estáticas, que no restauran,
+ * para no reseleccionar en cada píxel.
+ */
+
+#include "ssd1306_canvas.h"
+
+#if SSD1306_USE_FB_CANVAS
+
+#include "ssd1306_framebuffer.h"
+#include "../fonts/ssd1306_font.h"
+
+static ssd1306_dev * const *cv_tiles;
+
+/* Coordenadas locales del último cv_map() */
+static uint8_t cv_lx, cv_ly;
+
+/*
+ * Seleccionar el panel que contiene (x, y) y dejar en cv_lx/cv_ly la
+ * posición dentro de él. Retorna 0 si cae fuera del lienzo.
+ * Con WIDTH/HEIGHT potencia de 2 las divisiones son desplazamientos.
+ */
+static uint8_t cv_map(uint8_t x, uint8_t y) {
+    ssd1306_dev *dev;
+    
+#if SSD1306_CANVAS_WIDTH < 256
+    if (x >= SSD1306_CANVAS_WIDTH) return 0;
+#endif
+#if SSD1306_CANVAS_HEIGHT < 256
+    if (y >= SSD1306_CANVAS_HEIGHT) return 0;
+#endif
+    
+    dev = cv_tiles[(uint8_t)(y / SSD1306_HEIGHT) * SSD1306_CANVAS_COLS + x / SSD1306_WIDTH];
+    if (dev != ssd1306_cur) ssd1306_select(dev);
+    cv_lx = x % SSD1306_WIDTH;
+    cv_ly = y % SSD1306_HEIGHT;
+    return 1;
+}
+
+/* Volver al display que tenía seleccionado quien llamó */
+#define CV_RESTORE(prev)    do { if (ssd1306_cur != (prev)) ssd1306_select(prev); } while (0)
+
+/* Píxel con modo FB_OR / FB_CLEAR / FB_XOR, sin restaurar la selección */
+static void cv_put(uint8_t x, uint8_t y, uint8_t mode) {
+    if (!cv_map(x, y)) return;
+    switch (mode) {
+    case FB_CLEAR:  fb_clear_pixel(cv_lx, cv_ly); break;
+    case FB_XOR:    fb_toggle_pixel(cv_lx, cv_ly); break;
+    default:        fb_set_pixel(cv_lx, cv_ly); break;
+    }
+}
+
+/* ============================================
+ * LIENZO
+ * ============================================ */
+
+void cv_init(ssd1306_dev * const *tiles) {
+    ssd1306_dev *prev = ssd1306_cur;
+    uint8_t t;
+    
+    cv_tiles = tiles;
+    for (t = 0; t < SSD1306_CANVAS_TILES; t++) {
+        fb_dev_init(tiles[t]);
+    }
+    CV_RESTORE(prev);
+}
+
+void cv_clear(void) {
+    ssd1306_dev *prev = ssd1306_cur;
+    uint8_t t;
+    
+    for (t = 0; t < SSD1306_CANVAS_TILES; t++) {
+        fb_dev_clear(cv_tiles[t]);
+    }
+    CV_RESTORE(prev);
+}
+
+void cv_flush(void) {
+#if SSD1306_USE_FB_DIRTY
+    fb_flush_dirty_multi(cv_tiles, SSD1306_CANVAS_TILES);   /* Ya restaura */
+#else
+    ssd1306_dev *prev = ssd1306_cur;
+    uint8_t t;
+    
+    for (t = 0; t < SSD1306_CANVAS_TILES; t++) {
+        fb_dev_flush(cv_tiles[t]);
+    }
+    CV_RESTORE(prev);
+#endif
+}
+
+void cv_set_pixel(uint8_t x, uint8_t y) {
+    ssd1306_dev *prev = ssd1306_cur;
+    
+    cv_put(x, y, FB_OR);
+    CV_RESTORE(prev);
+}
+
+void cv_clear_pixel(uint8_t x, uint8_t y) {
+    ssd1306_dev *prev = ssd1306_cur;
+    
+    cv_put(x, y, FB_CLEAR);
+    CV_RESTORE(prev);
+}
+
+void cv_toggle_pixel(uint8_t x, uint8_t y) {
+    ssd1306_dev *prev = ssd1306_cur;
+    
+    cv_put(x, y, FB_XOR);
+    CV_RESTORE(prev);
+}
+
+uint8_t cv_get_pixel(uint8_t x, uint8_t y) {
+    ssd1306_dev *prev = ssd1306_cur;
+    uint8_t on = cv_map(x, y) ? fb_get_pixel(cv_lx, cv_ly) : 0;
+    
+    CV_RESTORE(prev);
+    return on;
+}
+
+/* ============================================
+ * LÍNEAS (Bresenham en 16 bits: el lienzo pasa de 127)
+ * ============================================ */
+#if SSD1306_USE_FB_LINE
+
+static int16_t cv_abs(int16_t x) {
+    return (x < 0) ? -x : x;
+}
+
+void cv_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    ssd1306_dev *prev = ssd1306_cur;
+    int16_t dx = cv_abs(x1 - x0);
+    int16_t dy = -cv_abs(y1 - y0);
+    int8_t sx = (x0 < x1) ? 1 : -1;
+    int8_t sy = (y0 < y1) ? 1 : -1;
+    int16_t err = dx + dy;
+    int16_t e2;
+    
+    while (1) {
+        if (x0 >= 0 && y0 >= 0 && x0 < SSD1306_CANVAS_WIDTH && y0 < SSD1306_CANVAS_HEIGHT) {
+            cv_put((uint8_t)x0, (uint8_t)y0, FB_OR);
+        }
+    
+        if (x0 == x1 && y0 == y1) break;
+    
+        e2 = err << 1;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+    CV_RESTORE(prev);
+}
+
+/* Los bucles paran en el borde: x + i no debe dar la vuelta a 0 */
+static void cv_hspan(uint8_t x, uint8_t y, uint8_t width) {
+    uint8_t i;
+    for (i = 0; i < width && (uint16_t)x + i < SSD1306_CANVAS_WIDTH; i++) {
+        cv_put(x + i, y, FB_OR);
+    }
+}
+
+static void cv_vspan(uint8_t x, uint8_t y, uint8_t height) {
+    uint8_t i;
+    for (i = 0; i < height && (uint16_t)y + i < SSD1306_CANVAS_HEIGHT; i++) {
+        cv_put(x, y + i, FB_OR);
+    }
+}
+
+void cv_hline(uint8_t x, uint8_t y, uint8_t width) {
+    ssd1306_dev *prev = ssd1306_cur;
+    
+    cv_hspan(x, y, width);
+    CV_RESTORE(prev);
+}
+
+void cv_vline(uint8_t x, uint8_t y, uint8_t height) {
+    ssd1306_dev *prev = ssd1306_cur;
+    
+    cv_vspan(x, y, height);
+    CV_RESTORE(prev);
+}
+
+void cv_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+    ssd1306_dev *prev = ssd1306_cur;
+    
+    cv_hspan(x, y, w);
+    cv_hspan(x, y + h - 1, w);
+    cv_vspan(x, y, h);
+    cv_vspan(x + w - 1, y, h);
+    CV_RESTORE(prev);
+}
+
+#if SSD1306_USE_FB_FILL
+void cv_rect_filled(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+    ssd1306_dev *prev = ssd1306_cur;
+    uint8_t j;
+    
+    for (j = 0; j < h && (uint16_t)y + j < SSD1306_CANVAS_HEIGHT; j++) {
+        cv_hspan(x, y + j, w);
+    }
+    CV_RESTORE(prev);
+}
+#endif /* SSD1306_USE_FB_FILL */
+
+#endif /* SSD1306_USE_FB_LINE */
+
+/* ============================================
+ * TEXTO
+ * ============================================ */
+#if SSD1306_USE_TEXT
+
+uint8_t cv_text(uint8_t x, uint8_t y, const char *str) {
+    ssd1306_dev *prev = ssd1306_cur;
+    const uint8_t *glyph;
+    uint8_t width = font_get_width();
+    uint8_t col, row, bits;
+    uint16_t px = x;
+    
+    while (*str && px < SSD1306_CANVAS_WIDTH) {
+        glyph = font_get_glyph(*str);
+        for (col = 0; col <= width && px < SSD1306_CANVAS_WIDTH; col++) {
+            bits = (col < width) ? glyph[col] : 0x00;   /* Última: espacio */
+            for (row = 0; row < 8 && (uint16_t)y + row < SSD1306_CANVAS_HEIGHT; row++) {
+                cv_put((uint8_t)px, y + row, (bits & (1 << row)) ? FB_OR : FB_CLEAR);
+            }
+            px++;
+        }
+        str++;
+    }
+    CV_RESTORE(prev);
+    return (uint8_t)px;
+}
+
+#endif /* SSD1306_USE_TEXT */
+
+/* ============================================
+ * GRÁFICAS
+ * ============================================ */
+#if SSD1306_USE_FB_PLOT
+
+void cv_plot(const uint8_t *data, uint8_t count, uint8_t x_offset) {
+    ssd1306_dev *prev = ssd1306_cur;
+    uint8_t i;
+    uint8_t y;
+    
+    for (i = 0; i < count && (uint16_t)x_offset + i < SSD1306_CANVAS_WIDTH; i++) {
+        y = data[i];
+#if SSD1306_CANVAS_HEIGHT < 256
+        if (y >= SSD1306_CANVAS_HEIGHT) y = SSD1306_CANVAS_HEIGHT - 1;
+#endif
+        cv_put(x_offset + i, SSD1306_CANVAS_HEIGHT - 1 - y, FB_OR);
+    }
+    CV_RESTORE(prev);
+}
+
+void cv_plot_scaled(const uint8_t *data, uint8_t count, uint8_t min_val, uint8_t max_val) {
+    ssd1306_dev *prev = ssd1306_cur;
+    uint8_t i;
+    uint8_t range = max_val - min_val;
+    uint8_t y;
+    
+    if (range == 0) range = 1;
+#if SSD1306_CANVAS_WIDTH < 256
+    if (count > SSD1306_CANVAS_WIDTH) count = SSD1306_CANVAS_WIDTH;
+#endif
+    
+    for (i = 0; i < count; i++) {
+        if (data[i] <= min_val) {
+            y = 0;
+        } else if (data[i] >= max_val) {
+            y = SSD1306_CANVAS_HEIGHT - 1;
+        } else {
+            y = ((uint16_t)(data[i] - min_val) * (SSD1306_CANVAS_HEIGHT - 1)) / range;
+        }
+        cv_put(i, SSD1306_CANVAS_HEIGHT - 1 - y, FB_OR);
+    }
+    CV_RESTORE(prev);
+}
+
+#endif /* SSD1306_USE_FB_PLOT */
+
+#endif /* SSD1306_USE_FB_CANVAS */
@@ -0,0 +1,101 @@
+/**
+ * ssd1306_canvas.h - Lienzo virtual sobre varios paneles
+ *
+ * Une SSD1306_CANVAS_COLS x SSD1306_CANVAS_ROWS displays (ssd1306_dev)
+ * en una sola superficie: dos 128x32 lado a lado son 256x32, uno sobre
+ * otro 128x64. Cada coordenada se traduce al panel (tile) que la
+ * contiene, así que líneas, texto y gráficas cruzan la junta sin más.
+ *
+ * Requiere SSD1306_USE_FRAMEBUFFER y SSD1306_USE_MULTI.
+ *
+ * Las funciones cv_* seleccionan cada panel que tocan, pero al terminar
+ * dejan seleccionado el display que lo estaba antes de llamarlas.
+ */
+
+#ifndef SSD1306_CANVAS_H
+#define SSD1306_CANVAS_H
+
+#include <stdint.h>
+#include <ssd1306/ssd1306_config.h>
+
+#if SSD1306_USE_FB_CANVAS
+
+#include "../core/ssd1306_core.h"   /* ssd1306_dev */
+
+#if !SSD1306_USE_FRAMEBUFFER || !SSD1306_USE_MULTI
+#error "SSD1306_USE_FB_CANVAS requiere SSD1306_USE_FRAMEBUFFER y SSD1306_USE_MULTI"
+#endif
+
+#define SSD1306_CANVAS_TILES    (SSD1306_CANVAS_COLS * SSD1306_CANVAS_ROWS)
+#define SSD1306_CANVAS_WIDTH    (SSD1306_WIDTH * SSD1306_CANVAS_COLS)
+#define SSD1306_CANVAS_HEIGHT   (SSD1306_HEIGHT * SSD1306_CANVAS_ROWS)
+
+#if SSD1306_CANVAS_WIDTH > 256 || SSD1306_CANVAS_HEIGHT > 256
+#error "El lienzo no puede pasar de 256 píxeles por lado"
+#endif
+
+/* ============================================
+ * LIENZO
+ * ============================================ */
+
+/** Asignar los paneles (SSD1306_CANVAS_TILES handles, por filas de
+ *  izquierda a derecha) e inicializar su framebuffer */
+void cv_init(ssd1306_dev * const *tiles);
+
+/** Limpiar todos los paneles */
+void cv_clear(void);
+
+/** Enviar todos los paneles (con FB_DIRTY: solo lo modificado, en una pasada) */
+void cv_flush(void);
+
+/** Píxeles en coordenadas del lienzo (fuera de él se ignoran) */
+void cv_set_pixel(uint8_t x, uint8_t y);
+void cv_clear_pixel(uint8_t x, uint8_t y);
+void cv_toggle_pixel(uint8_t x, uint8_t y);
+uint8_t cv_get_pixel(uint8_t x, uint8_t y);
+
+/* ============================================
+ * LÍNEAS (requiere SSD1306_USE_FB_LINE)
+ * ============================================ */
+#if SSD1306_USE_FB_LINE
+
+/** Línea entre dos puntos (Bresenham); se recorta al lienzo */
+void cv_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+void cv_hline(uint8_t x, uint8_t y, uint8_t width);
+void cv_vline(uint8_t x, uint8_t y, uint8_t height);
+void cv_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+
+#if SSD1306_USE_FB_FILL
+void cv_rect_filled(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+#endif
+
+#endif /* SSD1306_USE_FB_LINE */
+
+/* ============================================
+ * TEXTO (requiere SSD1306_USE_TEXT)
+ * ============================================ */
+#if SSD1306_USE_TEXT
+
+/** Texto 5x7 en cualquier píxel (opaco: fondo de 8 filas apagado).
+ *  Retorna la x siguiente al último carácter. */
+uint8_t cv_text(uint8_t x, uint8_t y, const char *str);
+
+#endif /* SSD1306_USE_TEXT */
+
+/* ============================================
+ * GRÁFICAS (requiere SSD1306_USE_FB_PLOT)
+ * ============================================ */
+#if SSD1306_USE_FB_PLOT
+
+/** Graficar array de datos (0..CANVAS_HEIGHT-1) */
+void cv_plot(const uint8_t *data, uint8_t count, uint8_t x_offset);
+
+/** Graficar con escala automática a la altura del lienzo */
+void cv_plot_scaled(const uint8_t *data, uint8_t count, uint8_t min_val, uint8_t max_val);
+
+#endif /* SSD1306_USE_FB_PLOT */
+
+#endif /* SSD1306_USE_FB_CANVAS */
+
+#endif /* SSD1306_CANVAS_H */
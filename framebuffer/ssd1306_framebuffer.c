@@ -1,7 +1,7 @@
 /**
  * ssd1306_framebuffer.c - Frame buffer para SSD1306
  * 
- * Buffer de 512 bytes para display 128x32.
+ * Buffer de WIDTH x PAGES bytes (512 para 128x32).
  * Permite manipulación de píxeles individuales.
  */
 
@@ -9,23 +9,92 @@
 
 #if SSD1306_USE_FRAMEBUFFER
 
+#include <string.h>
 #include "../core/ssd1306_core.h"
-#include "../../i2c/i2c.h"
+#if SSD1306_USE_FB_TEXT
+#include "../fonts/ssd1306_font.h"
+#endif
 
 /* ============================================
- * BUFFER (512 bytes para 128x32)
- * ============================================ */
+ * BUFFER (WIDTH x PAGES bytes: 512 para 128x32)
+ * ============================================
+ * Con FB_BAND solo se guarda la página band_page (WIDTH bytes).
+ * FB_ROW(page) es la posición de la página dentro del buffer.
+ */
+#if SSD1306_USE_FB_BAND
+static uint8_t framebuffer[SSD1306_WIDTH];
+static uint8_t band_page = 0;
+#define FB_ROW(page)        0
+#define FB_SIZE             SSD1306_WIDTH
+#else
+#if SSD1306_USE_MULTI
+/* Buffer y regiones sucias del display seleccionado (ssd1306_cur) */
+uint8_t ssd1306_fb_default[SSD1306_WIDTH * SSD1306_PAGES];
+#define framebuffer         (ssd1306_cur->fb)
+#else
 static uint8_t framebuffer[SSD1306_WIDTH * SSD1306_PAGES];
+#endif
+#define FB_ROW(page)        ((uint16_t)(page) * SSD1306_WIDTH)
+#define FB_SIZE             (SSD1306_WIDTH * SSD1306_PAGES)
+#endif
+
+/* ============================================
+ * REGIONES SUCIAS (requiere SSD1306_USE_FB_DIRTY)
+ * ============================================
+ * Por cada página se guarda el rango de columnas modificado [x0, x1].
+ * Página limpia: x0 > x1 (x0 = 0xFF, x1 = 0). Total: 2 bytes por página.
+ */
+#if SSD1306_USE_FB_DIRTY
+#if SSD1306_USE_MULTI
+#define dirty_x0            (ssd1306_cur->dirty_x0)
+#define dirty_x1            (ssd1306_cur->dirty_x1)
+#else
+static uint8_t dirty_x0[SSD1306_PAGES] = SSD1306_DIRTY_CLEAN;
+static uint8_t dirty_x1[SSD1306_PAGES];
+#endif
+
+#define FB_MARK(page, x) do { \
+    if ((x) < dirty_x0[page]) dirty_x0[page] = (x); \
+    if ((x) > dirty_x1[page]) dirty_x1[page] = (x); \
+} while (0)
+
+/* Marcar un rango de páginas completo como sucio */
+static void fb_mark_pages(uint8_t page0, uint8_t page1) {
+    uint8_t page;
+    for (page = page0; page <= page1; page++) {
+        dirty_x0[page] = 0;
+        dirty_x1[page] = SSD1306_WIDTH - 1;
+    }
+}
+
+/* Marcar todas las páginas como limpias */
+static void fb_mark_clean(void) {
+    uint8_t page;
+    for (page = 0; page < SSD1306_PAGES; page++) {
+        dirty_x0[page] = 0xFF;
+        dirty_x1[page] = 0;
+    }
+}
+#else
+#define FB_MARK(page, x)
+#endif /* SSD1306_USE_FB_DIRTY */
 
 /* ============================================
  * FUNCIONES BÁSICAS
  * ============================================ */
 
-void fb_init(void) {
+uint8_t fb_init(void) {
     uint16_t i;
-    for (i = 0; i < sizeof(framebuffer); i++) {
+#if SSD1306_USE_MULTI
+    if (!framebuffer) return 0;         /* Display sin buffer propio */
+#endif
+    for (i = 0; i < FB_SIZE; i++) {
         framebuffer[i] = 0x00;
     }
+#if SSD1306_USE_FB_DIRTY
+    fb_mark_pages(0, SSD1306_PAGES - 1);
+#endif
+    return 1;
 }
 
 void fb_clear(void) {
@@ -34,32 +103,336 @@ void fb_clear(void) {
 
 void fb_fill(void) {
     uint16_t i;
-    for (i = 0; i < sizeof(framebuffer); i++) {
+    for (i = 0; i < FB_SIZE; i++) {
         framebuffer[i] = 0xFF;
     }
+#if SSD1306_USE_FB_DIRTY
+    fb_mark_pages(0, SSD1306_PAGES - 1);
+#endif
+}
+
+/* ============================================
+ * SHADOW (requiere SSD1306_USE_FB_SHADOW)
+ * ============================================
+ * Copia de lo que el panel muestra realmente (último contenido enviado).
+ * fb_flush() compara contra ella y envía solo los bytes cambiados.
+ */
+#if SSD1306_USE_FB_SHADOW
+static uint8_t shadow[SSD1306_WIDTH * SSD1306_PAGES];
+static uint8_t shadow_valid = 0;    /* 0 = contenido del panel desconocido */
+#endif
+
+#if !SSD1306_USE_FB_BAND
+/* Enviar columnas x0-x1 de una página (transacción ya abierta) */
+static void fb_send_span(uint16_t base, uint8_t x0, uint8_t x1) {
+    uint8_t n = x1 - x0 + 1;
+    
+    ssd1306_data_buf(&framebuffer[base + x0], n);
+#if SSD1306_USE_FB_SHADOW
+    memcpy(&shadow[base + x0], &framebuffer[base + x0], n);
+#endif
+}
+
+#if SSD1306_USE_FB_SHADOW
+/*
+ * Enviar solo los tramos que difieren del shadow.
+ * Huecos de hasta SSD1306_FB_SHADOW_GAP bytes iguales se envían igualmente
+ * para no pagar otra transacción + reposicionamiento (~9 bytes en el bus).
+ */
+static void fb_flush_diff(void) {
+    uint8_t page, col, end, last, c;
+    uint16_t base;
+    
+    for (page = 0; page < SSD1306_PAGES; page++) {
+        base = (uint16_t)page * SSD1306_WIDTH;
+#if SSD1306_USE_FB_DIRTY
+        /* Solo comparar dentro del rango modificado */
+        col = dirty_x0[page];
+        end = dirty_x1[page];
+#else
+        col = 0;
+        end = SSD1306_WIDTH - 1;
+#endif
+        while (col <= end) {
+            if (framebuffer[base + col] == shadow[base + col]) {
+                col++;
+                continue;
+            }
+            
+            /* Extender el tramo mientras el hueco no supere el umbral */
+            last = col;
+            for (c = col + 1; c <= end && c <= last + SSD1306_FB_SHADOW_GAP + 1; c++) {
+                if (framebuffer[base + c] != shadow[base + c]) last = c;
+            }
+            
+            ssd1306_data_begin(col, page);
+            fb_send_span(base, col, last);
+            ssd1306_data_end();
+            col = last + 1;
+        }
+    }
+}
+#endif /* SSD1306_USE_FB_SHADOW */
+
+/* ============================================
+ * FLUSH INCREMENTAL (requiere SSD1306_USE_FB_ASYNC)
+ * ============================================
+ * El envío se reparte en pasos de max_bytes. Al empezar cada página se
+ * copia su contenido a flush_snap, así dibujar durante el flush es seguro:
+ * lo que se dibuje en una página ya copiada sale en el siguiente flush.
+ */
+#if SSD1306_USE_FB_ASYNC
+static uint8_t flush_snap[SSD1306_WIDTH];
+static uint8_t flush_page = SSD1306_PAGES;  /* SSD1306_PAGES = inactivo */
+static uint8_t flush_col;                   /* Próxima columna a enviar */
+static uint8_t flush_end;                   /* Última columna de la página */
+
+/* Copiar la página actual (o su rango sucio) al snapshot */
+static void fb_async_load(void) {
+    uint8_t col;
+    uint16_t base = (uint16_t)flush_page * SSD1306_WIDTH;
+    
+#if SSD1306_USE_FB_DIRTY
+    flush_col = dirty_x0[flush_page];
+    flush_end = dirty_x1[flush_page];
+    dirty_x0[flush_page] = 0xFF;
+    dirty_x1[flush_page] = 0;
+#else
+    flush_col = 0;
+    flush_end = SSD1306_WIDTH - 1;
+#endif
+    for (col = flush_col; col <= flush_end; col++) {
+        flush_snap[col] = framebuffer[base + col];
+    }
+}
+
+/*
+ * Abandonar el flush incremental en curso. La página cargada ya no está
+ * marcada como sucia: con FB_DIRTY se vuelve a marcar lo que quedaba por
+ * enviar de ella, para que el siguiente flush (o el reinicio) lo incluya.
+ */
+static void fb_async_cancel(void) {
+    if (flush_page >= SSD1306_PAGES) return;
+#if SSD1306_USE_FB_DIRTY
+    if (flush_col <= flush_end) {
+        FB_MARK(flush_page, flush_col);
+        FB_MARK(flush_page, flush_end);
+    }
+#endif
+    flush_page = SSD1306_PAGES;
+}
+#define FB_ASYNC_CANCEL()   fb_async_cancel()
+
+/* Bytes pendientes: resto de la página actual + páginas siguientes */
+static uint16_t fb_async_remaining(void) {
+    uint16_t rem = 0;
+    uint8_t page;
+    
+    if (flush_col <= flush_end) {
+        rem = flush_end - flush_col + 1;
+    }
+    for (page = flush_page + 1; page < SSD1306_PAGES; page++) {
+#if SSD1306_USE_FB_DIRTY
+        if (dirty_x0[page] <= dirty_x1[page]) {
+            rem += dirty_x1[page] - dirty_x0[page] + 1;
+        }
+#else
+        rem += SSD1306_WIDTH;
+#endif
+    }
+    return rem;
+}
+
+void fb_flush_begin(void) {
+    SSD1306_STAT_FLUSH();
+    fb_async_cancel();
+    flush_page = 0;
+    fb_async_load();
+}
+
+uint16_t fb_flush_step(uint8_t max_bytes) {
+    uint8_t n;
+    uint16_t rem;
+    
+    while (max_bytes && flush_page < SSD1306_PAGES) {
+        if (flush_col > flush_end) {
+            /* Página terminada: cargar la siguiente */
+            if (++flush_page >= SSD1306_PAGES) break;
+            fb_async_load();
+            continue;
+        }
+        
+        n = flush_end - flush_col + 1;
+        if (n > max_bytes) n = max_bytes;
+        
+        ssd1306_data_begin(flush_col, flush_page);
+        ssd1306_data_buf(&flush_snap[flush_col], n);
+        ssd1306_data_end();
+#if SSD1306_USE_FB_SHADOW
+        memcpy(&shadow[(uint16_t)flush_page * SSD1306_WIDTH + flush_col], &flush_snap[flush_col], n);
+#endif
+        
+        flush_col += n;
+        max_bytes -= n;
+    }
+    
+    if (flush_page < SSD1306_PAGES) {
+        rem = fb_async_remaining();
+        if (rem) return rem;
+        flush_page = SSD1306_PAGES;
+    }
+    SSD1306_FLUSH_DONE();
+    return 0;
 }
 
+uint8_t fb_flush_busy(void) {
+    return flush_page < SSD1306_PAGES;
+}
+#else
+#define FB_ASYNC_CANCEL()
+#endif /* SSD1306_USE_FB_ASYNC */
+
 void fb_flush(void) {
-    uint8_t page, col;
+    uint8_t page;
+    
+    SSD1306_STAT_FLUSH();
+    FB_ASYNC_CANCEL();              /* Cancela un flush incremental en curso */
+#if SSD1306_USE_FB_SHADOW
+    if (shadow_valid) {
+        fb_flush_diff();
+#if SSD1306_USE_FB_DIRTY
+        fb_mark_clean();
+#endif
+        SSD1306_FLUSH_DONE();
+        return;
+    }
+    shadow_valid = 1;   /* Este envío completo sincroniza el shadow */
+#endif
     
+    /* Ventana completa: el buffer entero en 1 transacción */
+    ssd1306_window_begin(0, SSD1306_WIDTH - 1, 0, SSD1306_PAGES - 1);
     for (page = 0; page < SSD1306_PAGES; page++) {
-        ssd1306_set_pos(0, page);
-        i2c_start(SSD1306_ADDR, I2C_WRITE);
-        i2c_write_byte(0x40);  /* Data mode */
-        for (col = 0; col < SSD1306_WIDTH; col++) {
-            i2c_write_byte(framebuffer[page * SSD1306_WIDTH + col]);
+        fb_send_span((uint16_t)page * SSD1306_WIDTH, 0, SSD1306_WIDTH - 1);
+    }
+    ssd1306_data_end();
+#if SSD1306_USE_FB_DIRTY
+    fb_mark_clean();
+#endif
+    SSD1306_FLUSH_DONE();
+}
+#endif /* !SSD1306_USE_FB_BAND */
+
+#if SSD1306_USE_FB_BAND
+/* Dibujar la pantalla por bandas: draw() una vez por página */
+void fb_render(void (*draw)(void)) {
+    SSD1306_STAT_FLUSH();
+    for (band_page = 0; band_page < SSD1306_PAGES; band_page++) {
+        memset(framebuffer, 0, SSD1306_WIDTH);
+        draw();
+        ssd1306_data_begin(0, band_page);
+        ssd1306_data_buf(framebuffer, SSD1306_WIDTH);
+        ssd1306_data_end();
+    }
+    band_page = 0;
+    SSD1306_FLUSH_DONE();
+}
+
+uint8_t fb_band_page(void) {
+    return band_page;
+}
+#endif /* SSD1306_USE_FB_BAND */
+
+#if SSD1306_USE_FB_DIRTY
+/* Enviar solo los rangos modificados: una ventana (0x21/0x22) por página */
+void fb_flush_dirty(void) {
+    uint8_t page, x0, x1;
+    
+    SSD1306_STAT_FLUSH();
+    FB_ASYNC_CANCEL();
+    for (page = 0; page < SSD1306_PAGES; page++) {
+        x0 = dirty_x0[page];
+        x1 = dirty_x1[page];
+        if (x0 > x1) continue;
+        
+        ssd1306_window_begin(x0, x1, page, page);
+        fb_send_span((uint16_t)page * SSD1306_WIDTH, x0, x1);
+        ssd1306_data_end();
+        
+        dirty_x0[page] = 0xFF;
+        dirty_x1[page] = 0;
+    }
+    SSD1306_FLUSH_DONE();
+}
+
+#if SSD1306_USE_MULTI
+/* Página a página, un tramo por display: cada tramo va a su dirección */
+void fb_flush_dirty_multi(ssd1306_dev * const *devs, uint8_t n) {
+    ssd1306_dev *prev = ssd1306_cur;
+    uint8_t page, d, x0, x1;
+    
+    SSD1306_STAT_FLUSH();
+    FB_ASYNC_CANCEL();
+    for (page = 0; page < SSD1306_PAGES; page++) {
+        for (d = 0; d < n; d++) {
+            ssd1306_select(devs[d]);
+            x0 = dirty_x0[page];
+            x1 = dirty_x1[page];
+            if (x0 > x1) continue;
+            
+            ssd1306_window_begin(x0, x1, page, page);
+            fb_send_span((uint16_t)page * SSD1306_WIDTH, x0, x1);
+            ssd1306_data_end();
+            
+            dirty_x0[page] = 0xFF;
+            dirty_x1[page] = 0;
         }
-        i2c_stop();
+    }
+    for (d = 0; d < n; d++) {
+        ssd1306_select(devs[d]);
+        SSD1306_FLUSH_DONE();
+    }
+    ssd1306_select(prev);
+}
+#endif /* SSD1306_USE_MULTI */
+#endif /* SSD1306_USE_FB_DIRTY */
+
+#if SSD1306_USE_FB_DIRTY || SSD1306_USE_FB_SHADOW
+/* Marcar todo el buffer como sucio (tras escribir vía fb_get_buffer
+ * o tras modificar el panel por fuera del framebuffer) */
+void fb_invalidate(void) {
+#if SSD1306_USE_FB_DIRTY
+    fb_mark_pages(0, SSD1306_PAGES - 1);
+#endif
+#if SSD1306_USE_FB_SHADOW
+    shadow_valid = 0;
+#endif
+}
+#endif
+
+#if SSD1306_USE_FB_DIRTY
+/* Marcar un rectángulo como sucio (x0-x1 columnas, page0-page1 páginas) */
+void fb_invalidate_rect(uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1) {
+    uint8_t page;
+    if (x1 >= SSD1306_WIDTH) x1 = SSD1306_WIDTH - 1;
+    if (page1 >= SSD1306_PAGES) page1 = SSD1306_PAGES - 1;
+    for (page = page0; page <= page1; page++) {
+        FB_MARK(page, x0);
+        FB_MARK(page, x1);
     }
 }
+#endif /* SSD1306_USE_FB_DIRTY */
 
 void fb_set_pixel(uint8_t x, uint8_t y) {
     uint8_t page, bit;
     if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) return;
     
     page = y >> 3;          /* y / 8 */
+#if SSD1306_USE_FB_BAND
+    if (page != band_page) return;      /* Fuera de la banda actual */
+#endif
     bit = y & 0x07;         /* y % 8 */
-    framebuffer[page * SSD1306_WIDTH + x] |= (1 << bit);
+    framebuffer[FB_ROW(page) + x] |= (1 << bit);
+    FB_MARK(page, x);
 }
 
 void fb_clear_pixel(uint8_t x, uint8_t y) {
@@ -67,8 +440,12 @@ void fb_clear_pixel(uint8_t x, uint8_t y) {
     if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) return;
     
     page = y >> 3;
+#if SSD1306_USE_FB_BAND
+    if (page != band_page) return;      /* Fuera de la banda actual */
+#endif
     bit = y & 0x07;
-    framebuffer[page * SSD1306_WIDTH + x] &= ~(1 << bit);
+    framebuffer[FB_ROW(page) + x] &= ~(1 << bit);
+    FB_MARK(page, x);
 }
 
 void fb_toggle_pixel(uint8_t x, uint8_t y) {
@@ -76,8 +453,12 @@ void fb_toggle_pixel(uint8_t x, uint8_t y) {
     if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) return;
     
     page = y >> 3;
+#if SSD1306_USE_FB_BAND
+    if (page != band_page) return;      /* Fuera de la banda actual */
+#endif
     bit = y & 0x07;
-    framebuffer[page * SSD1306_WIDTH + x] ^= (1 << bit);
+    framebuffer[FB_ROW(page) + x] ^= (1 << bit);
+    FB_MARK(page, x);
 }
 
 uint8_t fb_get_pixel(uint8_t x, uint8_t y) {
@@ -85,14 +466,66 @@ uint8_t fb_get_pixel(uint8_t x, uint8_t y) {
     if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) return 0;
     
     page = y >> 3;
+#if SSD1306_USE_FB_BAND
+    if (page != band_page) return 0;
+#endif
     bit = y & 0x07;
-    return (framebuffer[page * SSD1306_WIDTH + x] >> bit) & 0x01;
+    return (framebuffer[FB_ROW(page) + x] >> bit) & 0x01;
 }
 
 uint8_t* fb_get_buffer(void) {
     return framebuffer;
 }
 
+/* ============================================
+ * TRAMOS (líneas rectas y rellenos)
+ * ============================================
+ * Un rectángulo [x0, x1] x [y0, y1] ya recortado se escribe página a
+ * página: en cada una, una máscara de las filas cubiertas y una
+ * operación por columna. Un rectángulo de pantalla completa son
+ * WIDTH * PAGES operaciones de byte en vez de WIDTH * HEIGHT píxeles.
+ */
+#if SSD1306_USE_FB_LINE || (SSD1306_USE_FB_CIRCLE && SSD1306_USE_FB_FILL)
+
+/* Bits desde la fila n hacia abajo / hasta la fila n */
+static const uint8_t mask_from[8] = { 0xFF, 0xFE, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80 };
+static const uint8_t mask_to[8]   = { 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF };
+
+static void fb_span(uint8_t x0, uint8_t x1, uint8_t y0, uint8_t y1, uint8_t mode) {
+    uint8_t page = y0 >> 3;
+    uint8_t last = y1 >> 3;
+    uint8_t mask, n;
+    uint8_t *p;
+    
+    for (; page <= last; page++) {
+#if SSD1306_USE_FB_BAND
+        if (page != band_page) continue;    /* Fuera de la banda actual */
+#endif
+        mask = 0xFF;
+        if (page == (y0 >> 3)) mask = mask_from[y0 & 0x07];
+        if (page == last) mask &= mask_to[y1 & 0x07];
+        
+        p = &framebuffer[FB_ROW(page) + x0];
+        n = x1 - x0 + 1;
+        switch (mode) {
+        case FB_CLEAR:
+            mask = ~mask;
+            do { *p++ &= mask; } while (--n);
+            break;
+        case FB_XOR:
+            do { *p++ ^= mask; } while (--n);
+            break;
+        default:    /* FB_OR */
+            do { *p++ |= mask; } while (--n);
+            break;
+        }
+        FB_MARK(page, x0);
+        FB_MARK(page, x1);
+    }
+}
+
+#endif /* SSD1306_USE_FB_LINE || (SSD1306_USE_FB_CIRCLE && SSD1306_USE_FB_FILL) */
+
 /* ============================================
  * LÍNEAS (Bresenham)
  * ============================================ */
@@ -128,18 +561,24 @@ void fb_line(int8_t x0, int8_t y0, int8_t x1, int8_t y1) {
     }
 }
 
+/* Recortar una vez y pasar el rectángulo a fb_span() */
+void fb_fill_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t mode) {
+    uint16_t x1, y1;
+    
+    if (w == 0 || h == 0 || x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) return;
+    x1 = (uint16_t)x + w - 1;
+    y1 = (uint16_t)y + h - 1;
+    if (x1 >= SSD1306_WIDTH) x1 = SSD1306_WIDTH - 1;
+    if (y1 >= SSD1306_HEIGHT) y1 = SSD1306_HEIGHT - 1;
+    fb_span(x, (uint8_t)x1, y, (uint8_t)y1, mode);
+}
+
 void fb_hline(uint8_t x, uint8_t y, uint8_t width) {
-    uint8_t i;
-    for (i = 0; i < width; i++) {
-        fb_set_pixel(x + i, y);
-    }
+    fb_fill_rect(x, y, width, 1, FB_OR);
 }
 
 void fb_vline(uint8_t x, uint8_t y, uint8_t height) {
-    uint8_t i;
-    for (i = 0; i < height; i++) {
-        fb_set_pixel(x, y + i);
-    }
+    fb_fill_rect(x, y, 1, height, FB_OR);
 }
 
 void fb_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
@@ -151,12 +590,7 @@ void fb_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
 
 #if SSD1306_USE_FB_FILL
 void fb_rect_filled(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
-    uint8_t i, j;
-    for (j = 0; j < h; j++) {
-        for (i = 0; i < w; i++) {
-            fb_set_pixel(x + i, y + j);
-        }
-    }
+    fb_fill_rect(x, y, w, h, FB_OR);
 }
 #endif /* SSD1306_USE_FB_FILL */
 
@@ -199,13 +633,17 @@ void fb_circle(int8_t cx, int8_t cy, uint8_t r) {
 }
 
 #if SSD1306_USE_FB_FILL
-/* Línea horizontal para relleno */
+/* Línea horizontal para relleno, recortada en coordenadas con signo */
 static void fb_hline_fill(int8_t x0, int8_t x1, int8_t y) {
     int8_t x;
     if (x0 > x1) { x = x0; x0 = x1; x1 = x; }
-    for (x = x0; x <= x1; x++) {
-        fb_set_pixel(x, y);
-    }
+    if (y < 0 || y >= SSD1306_HEIGHT || x1 < 0) return;
+#if SSD1306_WIDTH < 128
+    if (x0 >= SSD1306_WIDTH) return;
+    if (x1 >= SSD1306_WIDTH) x1 = SSD1306_WIDTH - 1;
+#endif
+    if (x0 < 0) x0 = 0;
+    fb_span((uint8_t)x0, (uint8_t)x1, (uint8_t)y, (uint8_t)y, FB_OR);
 }
 
 void fb_circle_filled(int8_t cx, int8_t cy, uint8_t r) {
@@ -304,6 +742,88 @@ void fb_plot_scroll(uint8_t value, uint8_t min_val, uint8_t max_val) {
 
 #endif /* SSD1306_USE_FB_PLOT */
 
+/* ============================================
+ * TEXTO
+ * ============================================
+ * Cada columna del glifo (bit 0 = fila superior) se desplaza y/8 bits:
+ * la parte baja va a la página y>>3 y la alta a la siguiente. La
+ * máscara m marca las 8 filas de la celda para el modo opaco.
+ */
+#if SSD1306_USE_FB_TEXT
+
+#define FB_BLIT(dst, v, m) \
+    switch (mode) { \
+    case FB_OR:         (dst) |= (v); break; \
+    case FB_CLEAR:      (dst) &= ~(v); break; \
+    case FB_XOR:        (dst) ^= (v); break; \
+    default:            (dst) = ((dst) & ~(m)) | (v); break; \
+    }
+
+/* Dibujar un glifo y su columna de espacio. Retorna la x siguiente */
+static uint8_t fb_glyph(uint8_t x, uint8_t y, const uint8_t *glyph, uint8_t mode) {
+    uint8_t width = font_get_width();
+    uint8_t page = y >> 3;
+    uint8_t shift = y & 0x07;
+    uint8_t col, g;
+    uint8_t *lo;
+    uint8_t *hi;
+#if SSD1306_USE_FB_DIRTY
+    uint8_t x0 = x;
+#endif
+    
+    lo = &framebuffer[FB_ROW(page) + x];
+    hi = lo + SSD1306_WIDTH;
+#if SSD1306_USE_FB_BAND
+    /* En bandas solo existe band_page: la parte alta cae en ella si el
+     * glifo viene de la página anterior */
+    hi = lo;
+    if (!shift || page + 1 != band_page) hi = 0;
+    if (page != band_page) lo = 0;
+#else
+    if (!shift || page + 1 >= SSD1306_PAGES) hi = 0;
+#endif
+    
+    for (col = 0; col <= width && x < SSD1306_WIDTH; col++, x++) {
+        g = (col < width) ? glyph[col] : 0x00;  /* Última: espacio */
+        if (lo) {
+            FB_BLIT(*lo, (uint8_t)(g << shift), (uint8_t)(0xFF << shift));
+            lo++;
+        }
+        if (hi) {
+            FB_BLIT(*hi, (uint8_t)(g >> (8 - shift)), (uint8_t)(0xFF >> (8 - shift)));
+            hi++;
+        }
+    }
+    
+#if SSD1306_USE_FB_DIRTY
+    if (x > x0) {
+        FB_MARK(page, x0);
+        FB_MARK(page, x - 1);
+        if (hi) {
+            FB_MARK(page + 1, x0);
+            FB_MARK(page + 1, x - 1);
+        }
+    }
+#endif
+    return x;
+}
+
+void fb_char(uint8_t x, uint8_t y, char c, uint8_t mode) {
+    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) return;
+    fb_glyph(x, y, font_get_glyph(c), mode);
+}
+
+uint8_t fb_text(uint8_t x, uint8_t y, const char *str, uint8_t mode) {
+    if (y >= SSD1306_HEIGHT) return x;
+    while (*str && x < SSD1306_WIDTH) {
+        x = fb_glyph(x, y, font_get_glyph(*str), mode);
+        str++;
+    }
+    return x;
+}
+
+#endif /* SSD1306_USE_FB_TEXT */
+
 /* ============================================
  * SPRITES
  * ============================================ */
@@ -2,7 +2,7 @@
  * ssd1306_framebuffer.h - Frame buffer para SSD1306
  * 
  * Permite manipulación de píxeles individuales.
- * Requiere 512 bytes de RAM para display 128x32.
+ * Requiere WIDTH x PAGES bytes de RAM (512 para 128x32).
  * 
  * Módulos opcionales (configurar en ssd1306_config.h):
  *   SSD1306_USE_FRAMEBUFFER  - Buffer básico + set/clear pixel
@@ -10,6 +10,14 @@
  *   SSD1306_USE_FB_CIRCLE    - Círculos
  *   SSD1306_USE_FB_FILL      - Rectángulos/círculos rellenos
  *   SSD1306_USE_FB_PLOT      - Gráficas de datos
+ *   SSD1306_USE_FB_TEXT      - Texto 5x7 en cualquier posición
+ *   SSD1306_USE_FB_DIRTY     - Regiones sucias + fb_flush_dirty()
+ *   SSD1306_USE_FB_SHADOW    - fb_flush() envía solo bytes cambiados (+512 B)
+ *   SSD1306_USE_FB_ASYNC     - Flush incremental no bloqueante (+131 B)
+ *   SSD1306_USE_FB_BAND      - Render por bandas: buffer de una página (WIDTH B)
+ * 
+ * Con SSD1306_USE_MULTI cada display (ssd1306_dev) tiene su buffer y sus
+ * regiones sucias; las fb_* actúan sobre el display seleccionado.
  */
 
 #ifndef SSD1306_FRAMEBUFFER_H
@@ -20,12 +28,25 @@
 
 #if SSD1306_USE_FRAMEBUFFER
 
+#if SSD1306_USE_MULTI
+#include "../core/ssd1306_core.h"   /* ssd1306_dev */
+#endif
+
+#if SSD1306_USE_FB_BAND && (SSD1306_USE_FB_DIRTY || SSD1306_USE_FB_SHADOW || SSD1306_USE_FB_ASYNC)
+#error "SSD1306_USE_FB_BAND no es compatible con FB_DIRTY, FB_SHADOW ni FB_ASYNC"
+#endif
+
+#if SSD1306_USE_MULTI && (SSD1306_USE_FB_SHADOW || SSD1306_USE_FB_ASYNC || SSD1306_USE_FB_BAND)
+#error "SSD1306_USE_MULTI no es compatible con FB_SHADOW, FB_ASYNC ni FB_BAND"
+#endif
+
 /* ============================================
  * BUFFER BÁSICO (siempre incluido con FRAMEBUFFER)
  * ============================================ */
 
-/** Inicializar framebuffer (llenar con 0) */
-void fb_init(void);
+/** Inicializar framebuffer (llenar con 0). Retorna 1, o 0 con MULTI si el
+ *  display seleccionado no tiene buffer (handle preparado con fb = NULL) */
+uint8_t fb_init(void);
 
 /** Limpiar framebuffer (todos los píxeles apagados) */
 void fb_clear(void);
@@ -33,8 +54,10 @@ void fb_clear(void);
 /** Llenar framebuffer (todos los píxeles encendidos) */
 void fb_fill(void);
 
-/** Enviar framebuffer al display */
+#if !SSD1306_USE_FB_BAND
+/** Enviar framebuffer al display (con FB_SHADOW: solo los bytes cambiados) */
 void fb_flush(void);
+#endif
 
 /** Setear un píxel (encender) */
 void fb_set_pixel(uint8_t x, uint8_t y);
@@ -51,6 +74,100 @@ uint8_t fb_get_pixel(uint8_t x, uint8_t y);
 /** Acceso directo al buffer (para funciones avanzadas) */
 uint8_t* fb_get_buffer(void);
 
+/* ============================================
+ * RENDER POR BANDAS (requiere SSD1306_USE_FB_BAND)
+ * ============================================
+ * El buffer guarda una sola página. fb_render() llama a draw() una vez
+ * por página con el buffer limpio; los fb_* recortan a la banda actual
+ * y la banda se envía al terminar draw(). draw() debe redibujar la
+ * escena completa cada vez, usar solo fb_* y no cambiar estado.
+ */
+#if SSD1306_USE_FB_BAND
+
+/** Dibujar la pantalla completa banda a banda */
+void fb_render(void (*draw)(void));
+
+/** Página que se está dibujando (para saltar lo que no la toca) */
+uint8_t fb_band_page(void);
+
+#endif /* SSD1306_USE_FB_BAND */
+
+/* ============================================
+ * REGIONES SUCIAS (requiere SSD1306_USE_FB_DIRTY)
+ * ============================================ */
+#if SSD1306_USE_FB_DIRTY
+
+/** Enviar solo las columnas modificadas de cada página desde el último flush */
+void fb_flush_dirty(void);
+
+/** Marcar columnas x0-x1 de las páginas page0-page1 como modificadas */
+void fb_invalidate_rect(uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1);
+
+#endif /* SSD1306_USE_FB_DIRTY */
+
+/* ============================================
+ * FLUSH INCREMENTAL (requiere SSD1306_USE_FB_ASYNC)
+ * ============================================ */
+#if SSD1306_USE_FB_ASYNC
+
+/** Iniciar un flush incremental (reinicia si ya había uno en curso).
+ *  Con FB_DIRTY solo se envían las regiones sucias. fb_flush() y
+ *  fb_flush_dirty() cancelan el que esté en curso; lo que quedaba por
+ *  enviar sale con ellos (o con el siguiente fb_flush_begin). */
+void fb_flush_begin(void);
+
+/** Enviar hasta max_bytes de datos. Retorna bytes pendientes (0 = terminado).
+ *  Cada página se copia a un snapshot al empezarla: se puede seguir dibujando
+ *  durante el flush; lo dibujado en páginas ya copiadas sale en el siguiente. */
+uint16_t fb_flush_step(uint8_t max_bytes);
+
+/** 1 si hay un flush incremental en curso */
+uint8_t fb_flush_busy(void);
+
+#endif /* SSD1306_USE_FB_ASYNC */
+
+/* ============================================
+ * VARIOS DISPLAYS (requiere SSD1306_USE_MULTI)
+ * ============================================
+ * ssd1306_default usa el buffer interno ssd1306_fb_default; los demás
+ * displays deben traer el suyo en ssd1306_dev_setup(). Sin él, fb_init()
+ * retorna 0 y el resto de fb_* no debe usarse sobre ese display.
+ */
+#if SSD1306_USE_MULTI
+
+#define fb_dev_init(dev)                (ssd1306_select(dev), fb_init())
+#define fb_dev_clear(dev)               (ssd1306_select(dev), fb_clear())
+#define fb_dev_fill(dev)                (ssd1306_select(dev), fb_fill())
+#define fb_dev_flush(dev)               (ssd1306_select(dev), fb_flush())
+#define fb_dev_set_pixel(dev, x, y)     (ssd1306_select(dev), fb_set_pixel(x, y))
+#define fb_dev_clear_pixel(dev, x, y)   (ssd1306_select(dev), fb_clear_pixel(x, y))
+#define fb_dev_toggle_pixel(dev, x, y)  (ssd1306_select(dev), fb_toggle_pixel(x, y))
+#define fb_dev_get_pixel(dev, x, y)     (ssd1306_select(dev), fb_get_pixel(x, y))
+
+#if SSD1306_USE_FB_DIRTY
+#define fb_dev_flush_dirty(dev)         (ssd1306_select(dev), fb_flush_dirty())
+
+/** Enviar las regiones sucias de n displays en una sola pasada:
+ *  página a página, un tramo por display. Deja seleccionado el mismo
+ *  display que había al llamar. */
+void fb_flush_dirty_multi(ssd1306_dev * const *devs, uint8_t n);
+#endif
+
+#endif /* SSD1306_USE_MULTI */
+
+#if SSD1306_USE_FB_DIRTY || SSD1306_USE_FB_SHADOW
+/** Forzar reenvío completo en el próximo flush (p.ej. tras usar fb_get_buffer
+ *  o tras ssd1306_clear()) */
+void fb_invalidate(void);
+#endif
+
+/* Modos de dibujo (fb_fill_rect, fb_text, fb_char) */
+#define FB_OR           0   /* Encender */
+#define FB_CLEAR        1   /* Apagar */
+#define FB_XOR          2   /* Invertir */
+#define FB_OPAQUE       3   /* Texto: glifo y fondo (celda de 8 filas). En
+                               fb_fill_rect equivale a FB_OR */
+
 /* ============================================
  * LÍNEAS (requiere SSD1306_USE_FB_LINE)
  * ============================================ */
@@ -65,6 +182,10 @@ void fb_hline(uint8_t x, uint8_t y, uint8_t width);
 /** Línea vertical (optimizada) */
 void fb_vline(uint8_t x, uint8_t y, uint8_t height);
 
+/** Rellenar un rectángulo con un modo: una operación por byte y página,
+ *  recortado al buffer. Con w o h = 1 es una línea. */
+void fb_fill_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t mode);
+
 #endif /* SSD1306_USE_FB_LINE */
 
 /* ============================================
@@ -113,6 +234,29 @@ void fb_plot_scroll(uint8_t value, uint8_t min_val, uint8_t max_val);
 
 #endif /* SSD1306_USE_FB_PLOT */
 
+/* ============================================
+ * TEXTO (requiere SSD1306_USE_FB_TEXT)
+ * ============================================
+ * El glifo se desplaza y se escribe byte a byte sobre las dos páginas
+ * que ocupa; lo que sale del buffer se recorta.
+ */
+#if SSD1306_USE_FB_TEXT
+
+/* Nombres anteriores de los modos FB_* */
+#define FB_TEXT_OR      FB_OR
+#define FB_TEXT_CLEAR   FB_CLEAR
+#define FB_TEXT_XOR     FB_XOR
+#define FB_TEXT_OPAQUE  FB_OPAQUE
+
+/** Dibujar un carácter (más la columna de espacio) en (x, y).
+ *  mode: FB_OR, FB_CLEAR, FB_XOR o FB_OPAQUE */
+void fb_char(uint8_t x, uint8_t y, char c, uint8_t mode);
+
+/** Dibujar texto en (x, y). Retorna la x tras el último carácter */
+uint8_t fb_text(uint8_t x, uint8_t y, const char *str, uint8_t mode);
+
+#endif /* SSD1306_USE_FB_TEXT */
+
 /* ============================================
  * SPRITES (requiere SSD1306_USE_FB_SPRITE)
  * ============================================ */
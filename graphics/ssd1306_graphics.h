@@ -42,4 +42,23 @@ void ssd1306_clear_area(uint8_t col, uint8_t page, uint8_t width);
 
 #endif /* SSD1306_USE_ICONS */
 
+#if SSD1306_USE_MULTI
+/* Variantes con handle (ver ssd1306_dev en core) */
+#if SSD1306_USE_GRAPHICS
+#define ssd1306_dev_hline(dev, x, p, w, pat)    (ssd1306_select(dev), ssd1306_hline(x, p, w, pat))
+#define ssd1306_dev_fill_page(dev, p, pat)      (ssd1306_select(dev), ssd1306_fill_page(p, pat))
+#endif
+#if SSD1306_USE_RECT
+#define ssd1306_dev_rect(dev, x, p, w, h)       (ssd1306_select(dev), ssd1306_rect(x, p, w, h))
+#endif
+#if SSD1306_USE_PROGRESS
+#define ssd1306_dev_progress_bar(dev, x, p, w, pct) \
+    (ssd1306_select(dev), ssd1306_progress_bar(x, p, w, pct))
+#endif
+#if SSD1306_USE_ICONS
+#define ssd1306_dev_icon8(dev, c, p, icon)      (ssd1306_select(dev), ssd1306_icon8(c, p, icon))
+#define ssd1306_dev_clear_area(dev, c, p, w)    (ssd1306_select(dev), ssd1306_clear_area(c, p, w))
+#endif
+#endif /* SSD1306_USE_MULTI */
+
 #endif /* SSD1306_GRAPHICS_H */
@@ -0,0 +1,241 @@
+/**
+ * bench_bus.c - Coste en el bus I2C de cada función pública
+ * 
+ * Ejecuta un escenario fijo por función contra host/i2c_mock.c y
+ * reporta transacciones, bytes en el bus y tiempo estimado de
+ * transferencia a 100 kHz y 400 kHz, en CSV:
+ * 
+ *   name,txn,bytes,us_100k,us_400k
+ * 
+ * Tiempo estimado: 9 bits por byte (8 + ACK) + ~2 bits por START/STOP.
+ * No incluye el tiempo de CPU del 6502 (ver bench_sim65.c).
+ * 
+ * Compilar desde el directorio que contiene ssd1306/:
+ * 
+ *   gcc -Issd1306/host/config -I. -o bench_bus \
+ *       ssd1306/host/bench_bus.c ssd1306/host/i2c_mock.c \
+ *       ssd1306/core/ssd1306_*.c ssd1306/transport/ssd1306_*.c \
+ *       ssd1306/fonts/font_*.c \
+ *       ssd1306/text/ssd1306_*.c ssd1306/numbers/ssd1306_*.c \
+ *       ssd1306/graphics/ssd1306_*.c ssd1306/scroll/ssd1306_*.c \
+ *       ssd1306/framebuffer/ssd1306_*.c ssd1306/bignum/ssd1306_*.c
+ * 
+ * Uso: ./bench_bus > base.csv         guardar referencia
+ *      ./bench_bus -c base.csv        comparar; retorna 1 si alguna
+ *                                     función usa más bytes o transacciones
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <ssd1306/ssd1306.h>
+#include "i2c_mock.h"
+
+/* ============================================
+ * ESCENARIOS
+ * ============================================ */
+
+static const uint8_t icon_heart[8] = {
+    0x0C, 0x1E, 0x3E, 0x7C, 0x7C, 0x3E, 0x1E, 0x0C
+};
+
+/* Escena de referencia para el framebuffer */
+static void fb_scene(void) {
+    fb_clear();
+    fb_line(0, 0, 127, 31);
+    fb_line(0, 31, 127, 0);
+    fb_circle(64, 16, 15);
+    fb_rect_filled(4, 4, 20, 10);
+    fb_rect(100, 2, 24, 28);
+}
+
+static void setup_fb(void)          { fb_init(); fb_scene(); }
+static void setup_fb_synced(void)   { fb_init(); fb_scene(); fb_flush(); }
+
+static void run_init(void)          { ssd1306_init(); }
+static void run_clear(void)         { ssd1306_clear(); }
+static void run_set_pos(void)       { ssd1306_set_pos(64, 2); }
+static void run_display_on(void)    { ssd1306_display_on(); }
+static void run_contrast(void)      { ssd1306_set_contrast(0x40); }
+static void run_invert(void)        { ssd1306_invert(1); }
+static void run_flip_h(void)        { ssd1306_flip_h(1); }
+static void run_char(void)          { ssd1306_char(0, 0, 'A'); }
+static void run_text(void)          { ssd1306_text(0, 0, "Hola Mundo!"); }
+static void run_text_inv(void)      { ssd1306_text_inv(0, 1, "ALERTA"); }
+static void run_number(void)        { ssd1306_number(0, 2, 12345); }
+static void run_number_signed(void) { ssd1306_number_signed(0, 2, -15); }
+static void run_hex8(void)          { ssd1306_hex8(0, 3, 0xAB); }
+static void run_hex16(void)         { ssd1306_hex16(0, 3, 0xCAFE); }
+static void run_hline(void)         { ssd1306_hline(0, 1, 128, 0xFF); }
+static void run_fill_page(void)     { ssd1306_fill_page(2, 0xAA); }
+static void run_rect(void)          { ssd1306_rect(0, 0, 128, 4); }
+static void run_progress(void)      { ssd1306_progress_bar(0, 2, 128, 50); }
+static void run_icon8(void)         { ssd1306_icon8(60, 1, icon_heart); }
+static void run_clear_area(void)    { ssd1306_clear_area(0, 1, 32); }
+static void run_bigchar(void)       { ssd1306_bigchar(0, 0, '8'); }
+static void run_bigchar_clear(void) { ssd1306_bigchar_clear(0, 0); }
+static void run_bigtext(void)       { ssd1306_bigtext(0, 0, "CPU"); }
+static void run_bigtext_center(void){ ssd1306_bigtext_center("HOLA"); }
+static void run_bignum_2digit(void) { ssd1306_bignum_2digit(0, 1, 42); }
+static void run_bignum_time(void)   { ssd1306_bignum_time(24, 1, 12, 34); }
+static void run_bignum_number(void) { ssd1306_bignum_number(0, 1, 1234, 4); }
+static void run_bignum24_time(void) { ssd1306_bignum24_time(0, 12, 34); }
+static void run_scroll_left(void)   { ssd1306_scroll_left(0, 3, 5); }
+static void run_scroll_stop(void)   { ssd1306_scroll_stop(); }
+static void run_fb_flush(void)      { fb_flush(); }
+static void run_fb_dirty_1px(void)  { fb_set_pixel(5, 5); fb_flush_dirty(); }
+static void run_fb_dirty_scene(void){ fb_scene(); fb_flush_dirty(); }
+static void run_fb_plot_scroll(void){ fb_plot_scroll(20, 0, 50); fb_flush(); }
+static void run_fb_step(void)       { fb_flush_begin(); while (fb_flush_step(32)) { } }
+
+/* Pantalla de estado típica: 4 líneas de texto */
+static void run_screen_status(void) {
+    ssd1306_text(0, 0, "Temp:   23 C");
+    ssd1306_text(0, 1, "Hum:    45 %");
+    ssd1306_text(0, 2, "Pres: 1013 hPa");
+    ssd1306_text(0, 3, "Bat:   3.7 V");
+}
+
+/* La misma pantalla con campos: ya mostrada, cambia una cifra */
+static ssd1306_field status_fields[4];
+
+static void status_fields_set(const char *temp) {
+    ssd1306_field_set(&status_fields[0], temp);
+    ssd1306_field_set(&status_fields[1], "Hum:    45 %");
+    ssd1306_field_set(&status_fields[2], "Pres: 1013 hPa");
+    ssd1306_field_set(&status_fields[3], "Bat:   3.7 V");
+}
+
+static void setup_status_fields(void) {
+    uint8_t i;
+    for (i = 0; i < 4; i++) {
+        ssd1306_field_init(&status_fields[i], 0, i, SSD1306_FIELD_MAX);
+    }
+    status_fields_set("Temp:   23 C");
+}
+
+static void run_screen_status_fields(void) { status_fields_set("Temp:   24 C"); }
+
+/* Reloj BigFont HH:MM + etiqueta */
+static void run_screen_clock(void) {
+    ssd1306_bignum_time_centered(12, 34);
+    ssd1306_text(40, 3, "ALARMA");
+}
+
+typedef struct {
+    const char *name;
+    void (*setup)(void);
+    void (*run)(void);
+} bench_case;
+
+static const bench_case cases[] = {
+    { "ssd1306_init",                0,               run_init },
+    { "ssd1306_clear",               0,               run_clear },
+    { "ssd1306_set_pos",             0,               run_set_pos },
+    { "ssd1306_display_on",          0,               run_display_on },
+    { "ssd1306_set_contrast",        0,               run_contrast },
+    { "ssd1306_invert",              0,               run_invert },
+    { "ssd1306_flip_h",              0,               run_flip_h },
+    { "ssd1306_char",                0,               run_char },
+    { "ssd1306_text",                0,               run_text },
+    { "ssd1306_text_inv",            0,               run_text_inv },
+    { "ssd1306_number",              0,               run_number },
+    { "ssd1306_number_signed",       0,               run_number_signed },
+    { "ssd1306_hex8",                0,               run_hex8 },
+    { "ssd1306_hex16",               0,               run_hex16 },
+    { "ssd1306_hline",               0,               run_hline },
+    { "ssd1306_fill_page",           0,               run_fill_page },
+    { "ssd1306_rect",                0,               run_rect },
+    { "ssd1306_progress_bar",        0,               run_progress },
+    { "ssd1306_icon8",               0,               run_icon8 },
+    { "ssd1306_clear_area",          0,               run_clear_area },
+    { "ssd1306_bigchar",             0,               run_bigchar },
+    { "ssd1306_bigchar_clear",       0,               run_bigchar_clear },
+    { "ssd1306_bigtext",             0,               run_bigtext },
+    { "ssd1306_bigtext_center",      0,               run_bigtext_center },
+    { "ssd1306_bignum_2digit",       0,               run_bignum_2digit },
+    { "ssd1306_bignum_time",         0,               run_bignum_time },
+    { "ssd1306_bignum_number",       0,               run_bignum_number },
+    { "ssd1306_bignum24_time",       0,               run_bignum24_time },
+    { "ssd1306_scroll_left",         0,               run_scroll_left },
+    { "ssd1306_scroll_stop",         0,               run_scroll_stop },
+    { "fb_flush",                    setup_fb,        run_fb_flush },
+    { "fb_flush_dirty_1px",          setup_fb_synced, run_fb_dirty_1px },
+    { "fb_flush_dirty_scene",        setup_fb_synced, run_fb_dirty_scene },
+    { "fb_plot_scroll+fb_flush",     setup_fb_synced, run_fb_plot_scroll },
+    { "fb_flush_step_32",            setup_fb,        run_fb_step },
+    { "screen_status",               0,               run_screen_status },
+    { "screen_status_fields",        setup_status_fields, run_screen_status_fields },
+    { "screen_clock",                0,               run_screen_clock },
+};
+
+#define NUM_CASES (sizeof(cases) / sizeof(cases[0]))
+
+/* ============================================
+ * MEDICIÓN
+ * ============================================ */
+
+typedef struct {
+    unsigned long txn;
+    unsigned long bytes;
+} bench_result;
+
+static bench_result results[NUM_CASES];
+
+/* Microsegundos en el bus a freq_hz */
+static double bus_us(const bench_result *r, double freq_hz) {
+    return ((double)r->bytes * 9.0 + (double)r->txn * 2.0) * 1e6 / freq_hz;
+}
+
+/* Comparar contra un CSV anterior. Retorna el número de regresiones */
+static int compare(const char *path) {
+    FILE *f = fopen(path, "r");
+    char line[256], name[128];
+    unsigned long txn, bytes;
+    unsigned int i;
+    int regressions = 0;
+    
+    if (!f) {
+        fprintf(stderr, "No se puede abrir %s\n", path);
+        return 1;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "%127[^,],%lu,%lu", name, &txn, &bytes) != 3) continue;
+        for (i = 0; i < NUM_CASES; i++) {
+            if (strcmp(cases[i].name, name) != 0) continue;
+            if (results[i].txn > txn || results[i].bytes > bytes) {
+                fprintf(stderr, "REGRESION %s: %lu txn / %lu bytes (antes %lu / %lu)\n",
+                        name, results[i].txn, results[i].bytes, txn, bytes);
+                regressions++;
+            }
+        }
+    }
+    fclose(f);
+    return regressions;
+}
+
+int main(int argc, char **argv) {
+    const i2c_mock_totals *t;
+    unsigned int i;
+    
+    ssd1306_init();
+    for (i = 0; i < NUM_CASES; i++) {
+        if (cases[i].setup) cases[i].setup();
+        i2c_mock_reset();
+        cases[i].run();
+        t = i2c_mock_get_totals();
+        results[i].txn = t->starts;
+        results[i].bytes = t->bytes;
+    }
+    
+    printf("name,txn,bytes,us_100k,us_400k\n");
+    for (i = 0; i < NUM_CASES; i++) {
+        printf("%s,%lu,%lu,%.0f,%.0f\n", cases[i].name,
+               results[i].txn, results[i].bytes,
+               bus_us(&results[i], 100000.0), bus_us(&results[i], 400000.0));
+    }
+    
+    if (argc > 2 && strcmp(argv[1], "-c") == 0) {
+        return compare(argv[2]) ? 1 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,192 @@
+/**
+ * bench_sim65.c - Ciclos 6502 por primitiva y por pantalla (sim65)
+ * 
+ * Mide el coste de CPU de la librería sin la placa: se compila con cc65
+ * para el target sim6502, se enlaza con host/i2c_stub.c (cuenta pero no
+ * espera) y se ejecuta en sim65. Los ciclos se leen de los contadores
+ * de periféricos de sim65 ($FFC0-$FFC9).
+ * 
+ * Salida en CSV:
+ * 
+ *   name,calls,cycles,cycles_per_call,i2c_bytes
+ * 
+ * Compilar desde el directorio que contiene ssd1306/:
+ * 
+ *   cl65 -t sim6502 -O -I ssd1306/host/config_sim65 -I . -o bench.prg \
+ *       ssd1306/host/bench_sim65.c ssd1306/host/i2c_stub.c \
+ *       ssd1306/core/ssd1306_core.c ssd1306/core/ssd1306_control.c \
+ *       ssd1306/transport/ssd1306_transport.c \
+ *       ssd1306/fonts/font_5x7_full.c ssd1306/text/ssd1306_text.c \
+ *       ssd1306/numbers/ssd1306_numbers.c ssd1306/graphics/ssd1306_graphics.c \
+ *       ssd1306/scroll/ssd1306_scroll.c ssd1306/framebuffer/ssd1306_framebuffer.c \
+ *       ssd1306/bignum/ssd1306_bigfont.c
+ *   sim65 bench.prg
+ * 
+ * A 1 MHz, ciclos = microsegundos.
+ */
+
+#include <stdio.h>
+#include <ssd1306/ssd1306.h>
+
+/* ============================================
+ * CONTADORES DE SIM65
+ * ============================================ */
+
+#define SIM65_LATCH         (*(volatile uint8_t*)0xFFC0)
+#define SIM65_SELECT        (*(volatile uint8_t*)0xFFC1)
+#define SIM65_VALUE         ((volatile uint8_t*)0xFFC2)
+#define SIM65_CLOCKCYCLES   0x00
+
+/* Contador de host/i2c_stub.c */
+extern unsigned long i2c_stub_bytes;
+
+/* Leer los 32 bits bajos del contador de ciclos */
+static unsigned long cycles_now(void) {
+    unsigned long c;
+    
+    SIM65_LATCH = 0;
+    SIM65_SELECT = SIM65_CLOCKCYCLES;
+    c = SIM65_VALUE[3];
+    c = (c << 8) | SIM65_VALUE[2];
+    c = (c << 8) | SIM65_VALUE[1];
+    c = (c << 8) | SIM65_VALUE[0];
+    return c;
+}
+
+/* ============================================
+ * ESCENARIOS
+ * ============================================ */
+
+static void fb_scene(void) {
+    fb_clear();
+    fb_line(0, 0, 127, 31);
+    fb_line(0, 31, 127, 0);
+    fb_circle(64, 16, 15);
+    fb_rect_filled(4, 4, 20, 10);
+    fb_rect(100, 2, 24, 28);
+}
+
+static void setup_fb(void)          { fb_init(); fb_scene(); }
+static void setup_fb_synced(void)   { fb_init(); fb_scene(); fb_flush(); }
+
+static void run_empty(void)         { }
+
+static void run_set_pixel(void) {
+    uint8_t x;
+    for (x = 0; x < 128; x++) {
+        fb_set_pixel(x, x & 31);
+    }
+}
+
+static void run_get_pixel(void) {
+    uint8_t x;
+    for (x = 0; x < 128; x++) {
+        fb_get_pixel(x, x & 31);
+    }
+}
+
+static void run_fb_clear(void)      { fb_clear(); }
+static void run_fb_line(void)       { fb_line(0, 0, 127, 31); }
+static void run_fb_hline(void)      { fb_hline(0, 10, 128); }
+static void run_fb_vline(void)      { fb_vline(10, 0, 32); }
+static void run_fb_circle(void)     { fb_circle(64, 16, 15); }
+static void run_fb_circle_f(void)   { fb_circle_filled(64, 16, 15); }
+static void run_fb_rect_f(void)     { fb_rect_filled(0, 0, 128, 32); }
+static void run_fb_plot_scroll(void){ fb_plot_scroll(20, 0, 50); }
+static void run_fb_flush(void)      { fb_flush(); }
+static void run_fb_dirty_1px(void)  { fb_set_pixel(5, 5); fb_flush_dirty(); }
+static void run_clear(void)         { ssd1306_clear(); }
+static void run_char(void)          { ssd1306_char(0, 0, 'A'); }
+static void run_text(void)          { ssd1306_text(0, 0, "Hola Mundo!"); }
+static void run_number(void)        { ssd1306_number(0, 2, 65535U); }
+static void run_number_small(void)  { ssd1306_number(0, 2, 7); }
+static void run_hex16(void)         { ssd1306_hex16(0, 3, 0xCAFE); }
+static void run_progress(void)      { ssd1306_progress_bar(0, 2, 128, 50); }
+static void run_bigchar(void)       { ssd1306_bigchar(0, 0, '8'); }
+static void run_bigtext(void)       { ssd1306_bigtext(0, 0, "CPU"); }
+static void run_bignum_time(void)   { ssd1306_bignum_time(24, 1, 12, 34); }
+
+static void run_screen_status(void) {
+    ssd1306_text(0, 0, "Temp:   23 C");
+    ssd1306_text(0, 1, "Hum:    45 %");
+    ssd1306_text(0, 2, "Pres: 1013 hPa");
+    ssd1306_text(0, 3, "Bat:   3.7 V");
+}
+
+static void run_screen_clock(void) {
+    ssd1306_bignum_time_centered(12, 34);
+    ssd1306_text(40, 3, "ALARMA");
+}
+
+static void run_screen_fb(void)     { fb_scene(); fb_flush(); }
+
+typedef struct {
+    const char *name;
+    uint8_t calls;              /* Llamadas dentro de run() */
+    void (*setup)(void);
+    void (*run)(void);
+} bench_case;
+
+static const bench_case cases[] = {
+    { "fb_set_pixel",               128, setup_fb,        run_set_pixel },
+    { "fb_get_pixel",               128, setup_fb,        run_get_pixel },
+    { "fb_clear",                   1,   setup_fb,        run_fb_clear },
+    { "fb_line",                    1,   setup_fb,        run_fb_line },
+    { "fb_hline",                   1,   setup_fb,        run_fb_hline },
+    { "fb_vline",                   1,   setup_fb,        run_fb_vline },
+    { "fb_circle",                  1,   setup_fb,        run_fb_circle },
+    { "fb_circle_filled",           1,   setup_fb,        run_fb_circle_f },
+    { "fb_rect_filled",             1,   setup_fb,        run_fb_rect_f },
+    { "fb_plot_scroll",             1,   setup_fb,        run_fb_plot_scroll },
+    { "fb_flush",                   1,   setup_fb,        run_fb_flush },
+    { "fb_flush_dirty_1px",         1,   setup_fb_synced, run_fb_dirty_1px },
+    { "ssd1306_clear",              1,   0,               run_clear },
+    { "ssd1306_char",               1,   0,               run_char },
+    { "ssd1306_text",               1,   0,               run_text },
+    { "ssd1306_number",             1,   0,               run_number },
+    { "ssd1306_number_1digit",      1,   0,               run_number_small },
+    { "ssd1306_hex16",              1,   0,               run_hex16 },
+    { "ssd1306_progress_bar",       1,   0,               run_progress },
+    { "ssd1306_bigchar",            1,   0,               run_bigchar },
+    { "ssd1306_bigtext",            1,   0,               run_bigtext },
+    { "ssd1306_bignum_time",        1,   0,               run_bignum_time },
+    { "screen_status",              1,   0,               run_screen_status },
+    { "screen_clock",               1,   0,               run_screen_clock },
+    { "screen_fb_scene",            1,   setup_fb,        run_screen_fb },
+};
+
+#define NUM_CASES (sizeof(cases) / sizeof(cases[0]))
+
+/* ============================================
+ * MEDICIÓN
+ * ============================================ */
+
+/* Ciclos de run(), descontando la llamada y la lectura del contador */
+static unsigned long measure(void (*run)(void), unsigned long overhead) {
+    unsigned long t0, t1;
+    
+    t0 = cycles_now();
+    run();
+    t1 = cycles_now();
+    return t1 - t0 - overhead;
+}
+
+int main(void) {
+    const bench_case *c;
+    unsigned long overhead, cyc;
+    uint8_t i;
+    
+    ssd1306_init();
+    overhead = measure(run_empty, 0);
+    
+    printf("name,calls,cycles,cycles_per_call,i2c_bytes\n");
+    for (i = 0; i < NUM_CASES; i++) {
+        c = &cases[i];
+        if (c->setup) c->setup();
+        i2c_stub_bytes = 0;
+        cyc = measure(c->run, overhead);
+        printf("%s,%u,%lu,%lu,%lu\n", c->name, c->calls,
+               cyc, cyc / c->calls, i2c_stub_bytes);
+    }
+    return 0;
+}
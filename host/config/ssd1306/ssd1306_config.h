@@ -0,0 +1,47 @@
+/**
+ * ssd1306_config.h - Configuración para compilar en PC (host)
+ * 
+ * Activa el backend I2C simulado y todos los módulos. El resto de
+ * valores se toma de la configuración por defecto de la librería.
+ * 
+ * Uso: compilar con -Issd1306/host/config ANTES de -I. (ver host/harness.c)
+ */
+
+#ifndef SSD1306_HOST_CONFIG_H
+#define SSD1306_HOST_CONFIG_H
+
+#define SSD1306_HOST_MOCK           1
+
+#define SSD1306_USE_CORE            1
+#define SSD1306_USE_INIT_EX         1
+#define SSD1306_USE_FONT_5X7_FULL   1
+#define SSD1306_USE_TEXT            1
+#define SSD1306_USE_TEXT_INV        1
+#define SSD1306_USE_TEXT_FIELD      1
+#define SSD1306_FIELD_MAX           14
+#define SSD1306_USE_NUMBERS         1
+#define SSD1306_USE_NUMBERS_HEX     1
+#define SSD1306_USE_NUMBERS_32      1
+#define SSD1306_USE_BIGNUM          1
+#define SSD1306_BIGNUM_LETTERS      1
+#define SSD1306_USE_BIGNUM24        1
+#define SSD1306_USE_GRAPHICS        1
+#define SSD1306_USE_RECT            1
+#define SSD1306_USE_PROGRESS        1
+#define SSD1306_USE_ICONS           1
+#define SSD1306_USE_SCROLL          1
+#define SSD1306_USE_CONTROL         1
+#define SSD1306_USE_FRAMEBUFFER     1
+#define SSD1306_USE_FB_LINE         1
+#define SSD1306_USE_FB_CIRCLE       1
+#define SSD1306_USE_FB_FILL         1
+#define SSD1306_USE_FB_PLOT         1
+#define SSD1306_USE_FB_SPRITE       1
+#define SSD1306_USE_FB_TEXT         1
+#define SSD1306_USE_FB_DIRTY        1
+#define SSD1306_USE_FB_ASYNC        1
+
+/* Valores por defecto para todo lo demás */
+#include "../../../ssd1306_config.h"
+
+#endif /* SSD1306_HOST_CONFIG_H */
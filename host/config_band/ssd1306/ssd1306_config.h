@@ -0,0 +1,47 @@
+/**
+ * ssd1306_config.h - Configuración host con framebuffer por bandas
+ * 
+ * Como host/config pero con SSD1306_USE_FB_BAND (buffer de una página y
+ * fb_render). BAND no admite FB_DIRTY, FB_SHADOW ni FB_ASYNC, así que
+ * esos módulos quedan fuera.
+ * 
+ * Uso: compilar con -Issd1306/host/config_band ANTES de -I. (ver host/test_emu.c)
+ */
+
+#ifndef SSD1306_HOST_CONFIG_H
+#define SSD1306_HOST_CONFIG_H
+
+#define SSD1306_HOST_MOCK           1
+
+#define SSD1306_USE_CORE            1
+#define SSD1306_USE_INIT_EX         1
+#define SSD1306_USE_FONT_5X7_FULL   1
+#define SSD1306_USE_TEXT            1
+#define SSD1306_USE_TEXT_INV        1
+#define SSD1306_USE_TEXT_FIELD      1
+#define SSD1306_FIELD_MAX           14
+#define SSD1306_USE_NUMBERS         1
+#define SSD1306_USE_NUMBERS_HEX     1
+#define SSD1306_USE_NUMBERS_32      1
+#define SSD1306_USE_BIGNUM          1
+#define SSD1306_BIGNUM_LETTERS      1
+#define SSD1306_USE_BIGNUM24        1
+#define SSD1306_USE_GRAPHICS        1
+#define SSD1306_USE_RECT            1
+#define SSD1306_USE_PROGRESS        1
+#define SSD1306_USE_ICONS           1
+#define SSD1306_USE_SCROLL          1
+#define SSD1306_USE_CONTROL         1
+#define SSD1306_USE_FRAMEBUFFER     1
+#define SSD1306_USE_FB_LINE         1
+#define SSD1306_USE_FB_CIRCLE       1
+#define SSD1306_USE_FB_FILL         1
+#define SSD1306_USE_FB_PLOT         1
+#define SSD1306_USE_FB_SPRITE       1
+#define SSD1306_USE_FB_TEXT         1
+#define SSD1306_USE_FB_BAND         1
+
+/* Valores por defecto para todo lo demás */
+#include "../../../ssd1306_config.h"
+
+#endif /* SSD1306_HOST_CONFIG_H */
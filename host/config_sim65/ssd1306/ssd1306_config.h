@@ -0,0 +1,41 @@
+/**
+ * ssd1306_config.h - Configuración para medir ciclos con sim65
+ * 
+ * Igual que la configuración host pero compilando con cc65 para el
+ * 6502: usa el driver I2C normal (../i2c/i2c.h), que en el benchmark
+ * se enlaza con host/i2c_stub.c en lugar de i2c.c.
+ * 
+ * Uso: compilar con -I ssd1306/host/config_sim65 ANTES de -I . (ver host/bench_sim65.c)
+ */
+
+#ifndef SSD1306_SIM65_CONFIG_H
+#define SSD1306_SIM65_CONFIG_H
+
+#define SSD1306_HOST_MOCK           0
+
+#define SSD1306_USE_CORE            1
+#define SSD1306_USE_FONT_5X7_FULL   1
+#define SSD1306_USE_TEXT            1
+#define SSD1306_USE_TEXT_INV        1
+#define SSD1306_USE_NUMBERS         1
+#define SSD1306_USE_NUMBERS_HEX     1
+#define SSD1306_USE_BIGNUM          1
+#define SSD1306_BIGNUM_LETTERS      1
+#define SSD1306_USE_GRAPHICS        1
+#define SSD1306_USE_RECT            1
+#define SSD1306_USE_PROGRESS        1
+#define SSD1306_USE_ICONS           1
+#define SSD1306_USE_SCROLL          1
+#define SSD1306_USE_CONTROL         1
+#define SSD1306_USE_FRAMEBUFFER     1
+#define SSD1306_USE_FB_LINE         1
+#define SSD1306_USE_FB_CIRCLE       1
+#define SSD1306_USE_FB_FILL         1
+#define SSD1306_USE_FB_PLOT         1
+#define SSD1306_USE_FB_SPRITE       1
+#define SSD1306_USE_FB_DIRTY        1
+
+/* Valores por defecto para todo lo demás */
+#include "../../../ssd1306_config.h"
+
+#endif /* SSD1306_SIM65_CONFIG_H */
@@ -0,0 +1,137 @@
+/**
+ * harness.c - Programa de prueba en PC con el backend I2C simulado
+ * 
+ * Enlaza todos los módulos contra host/i2c_mock.c, llama una vez a
+ * cada función pública y muestra cuántas transacciones y bytes
+ * generó en el bus.
+ * 
+ * Compilar desde el directorio que contiene ssd1306/:
+ * 
+ *   gcc -Issd1306/host/config -I. -o harness \
+ *       ssd1306/host/harness.c ssd1306/host/i2c_mock.c \
+ *       ssd1306/host/ssd1306_emu.c \
+ *       ssd1306/core/ssd1306_*.c ssd1306/transport/ssd1306_*.c \
+ *       ssd1306/fonts/font_*.c \
+ *       ssd1306/text/ssd1306_*.c ssd1306/numbers/ssd1306_*.c \
+ *       ssd1306/graphics/ssd1306_*.c ssd1306/scroll/ssd1306_*.c \
+ *       ssd1306/framebuffer/ssd1306_*.c ssd1306/bignum/ssd1306_*.c
+ * 
+ * Uso: ./harness        resumen por función
+ *      ./harness -v     además, volcar cada transacción
+ *      ./harness -a     además, mostrar la pantalla emulada tras cada llamada
+ *      ./harness -p f   guardar la pantalla final en f (PBM)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <ssd1306/ssd1306.h>
+#include "i2c_mock.h"
+#include "ssd1306_emu.h"
+
+static int verbose = 0;
+static int show_screen = 0;
+static ssd1306_emu emu;
+
+/* Mostrar lo que generó la última llamada y reiniciar el registro */
+static void report(const char *name) {
+    const i2c_mock_totals *t = i2c_mock_get_totals();
+    
+    printf("%-28s %6lu txn %8lu bytes\n", name,
+           (unsigned long)t->starts, (unsigned long)t->bytes);
+    if (verbose) {
+        i2c_mock_dump(stdout);
+    }
+    if (show_screen) {
+        ssd1306_emu_dump_ascii(&emu, stdout);
+    }
+    i2c_mock_reset();
+}
+
+static const uint8_t icon_heart[8] = {
+    0x0C, 0x1E, 0x3E, 0x7C, 0x7C, 0x3E, 0x1E, 0x0C
+};
+
+int main(int argc, char **argv) {
+    const char *pbm_file = 0;
+    FILE *f;
+    int i;
+    
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) verbose = 1;
+        else if (strcmp(argv[i], "-a") == 0) show_screen = 1;
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) pbm_file = argv[++i];
+    }
+    
+    ssd1306_emu_init(&emu, SSD1306_ADDR, SSD1306_WIDTH, SSD1306_HEIGHT);
+    ssd1306_emu_attach(&emu);
+    i2c_mock_reset();
+    
+    /* Core */
+    ssd1306_init();                         report("ssd1306_init");
+    ssd1306_clear();                        report("ssd1306_clear");
+    ssd1306_set_pos(10, 1);                 report("ssd1306_set_pos");
+    ssd1306_display_off();                  report("ssd1306_display_off");
+    ssd1306_display_on();                   report("ssd1306_display_on");
+    
+    /* Control */
+    ssd1306_set_contrast(0x40);             report("ssd1306_set_contrast");
+    ssd1306_invert(1);                      report("ssd1306_invert");
+    ssd1306_invert(0);
+    i2c_mock_reset();
+    
+    /* Texto y números */
+    ssd1306_char(0, 0, 'A');                report("ssd1306_char");
+    ssd1306_text(0, 0, "Hola Mundo!");      report("ssd1306_text");
+    ssd1306_text_inv(0, 1, "ALERTA");       report("ssd1306_text_inv");
+    ssd1306_number(0, 2, 12345);            report("ssd1306_number");
+    ssd1306_number_signed(0, 2, -15);       report("ssd1306_number_signed");
+    ssd1306_hex8(0, 3, 0xAB);               report("ssd1306_hex8");
+    ssd1306_hex16(0, 3, 0xCAFE);            report("ssd1306_hex16");
+    
+    /* Gráficos directos */
+    ssd1306_hline(0, 1, 128, 0xFF);         report("ssd1306_hline");
+    ssd1306_fill_page(2, 0xAA);             report("ssd1306_fill_page");
+    ssd1306_rect(0, 0, 64, 4);              report("ssd1306_rect");
+    ssd1306_progress_bar(0, 2, 128, 50);    report("ssd1306_progress_bar");
+    ssd1306_icon8(60, 1, icon_heart);       report("ssd1306_icon8");
+    ssd1306_clear_area(0, 1, 32);           report("ssd1306_clear_area");
+    
+    /* BigFont */
+    ssd1306_bigchar(0, 0, '8');             report("ssd1306_bigchar");
+    ssd1306_bigtext(0, 0, "CPU");           report("ssd1306_bigtext");
+    ssd1306_bignum_time_centered(12, 34);   report("ssd1306_bignum_time_centered");
+    ssd1306_bignum_number(0, 2, 1234, 4);   report("ssd1306_bignum_number");
+    
+    /* Dígitos 24x32 */
+    ssd1306_bignum24_time(0, 12, 34);       report("ssd1306_bignum24_time");
+    ssd1306_bignum24_time_full(0, 12, 34, 56); report("ssd1306_bignum24_time_full");
+    ssd1306_bignum24_number(0, 1234, 4);    report("ssd1306_bignum24_number");
+    
+    /* Scroll */
+    ssd1306_scroll_left(0, 0, 5);           report("ssd1306_scroll_left");
+    ssd1306_scroll_stop();                  report("ssd1306_scroll_stop");
+    
+    /* Framebuffer */
+    fb_init();
+    fb_line(0, 0, 127, 31);
+    fb_circle(64, 16, 15);
+    fb_rect_filled(4, 4, 20, 10);
+    i2c_mock_reset();
+    fb_flush();                             report("fb_flush");
+    fb_set_pixel(5, 5);
+    fb_flush_dirty();                       report("fb_flush_dirty (1 px)");
+    fb_plot_scroll(20, 0, 50);
+    fb_flush_dirty();                       report("fb_plot_scroll + dirty");
+    fb_clear();
+    fb_flush_begin();
+    while (fb_flush_step(32)) { }
+    report("fb_flush_step(32) x N");
+    
+    if (pbm_file) {
+        f = fopen(pbm_file, "w");
+        if (!f) return 1;
+        ssd1306_emu_write_pbm(&emu, f);
+        fclose(f);
+    }
+    return 0;
+}
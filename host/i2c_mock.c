@@ -0,0 +1,143 @@
+/**
+ * i2c_mock.c - Backend I2C simulado con registro de transacciones
+ */
+
+#include "i2c_mock.h"
+
+/* Tamaño máximo de una transacción (un flush 128x64 completo cabe holgado) */
+#define I2C_MOCK_MAX_CUR    4096
+
+static i2c_mock_txn txn_log[I2C_MOCK_MAX_TXN];
+static uint8_t byte_log[I2C_MOCK_MAX_BYTES];
+static uint16_t txn_count = 0;
+static uint32_t byte_count = 0;
+
+static i2c_mock_totals totals;
+
+/* Transacción en curso */
+static uint8_t cur_buf[I2C_MOCK_MAX_CUR];
+static uint16_t cur_len = 0;
+static uint8_t cur_addr = 0;
+static uint8_t cur_rw = 0;
+static uint8_t cur_open = 0;
+
+static uint8_t ack_value = 1;
+static i2c_mock_sink sink_fn = 0;
+
+/* Guardar la transacción en curso en el registro */
+static void mock_commit(void) {
+    i2c_mock_txn *t;
+    uint16_t i;
+    
+    if (sink_fn) {
+        sink_fn(cur_addr, cur_buf, cur_len);
+    }
+    
+    if (txn_count >= I2C_MOCK_MAX_TXN ||
+        byte_count + cur_len > I2C_MOCK_MAX_BYTES) {
+        totals.dropped++;
+        return;
+    }
+    
+    t = &txn_log[txn_count++];
+    t->addr = cur_addr;
+    t->rw = cur_rw;
+    t->len = cur_len;
+    t->offset = byte_count;
+    for (i = 0; i < cur_len; i++) {
+        byte_log[byte_count++] = cur_buf[i];
+    }
+}
+
+/* ============================================
+ * INTERFAZ I2C
+ * ============================================ */
+
+uint8_t i2c_start(uint8_t addr, uint8_t rw) {
+    /* START repetido: cerrar la transacción anterior */
+    if (cur_open) {
+        mock_commit();
+    }
+    cur_open = 1;
+    cur_addr = addr;
+    cur_rw = rw;
+    cur_len = 0;
+    
+    totals.starts++;
+    totals.bytes++;     /* Byte de dirección */
+    return ack_value;
+}
+
+uint8_t i2c_write_byte(uint8_t data) {
+    totals.bytes++;
+    if (cur_len < I2C_MOCK_MAX_CUR) {
+        cur_buf[cur_len++] = data;
+    }
+    return ack_value;
+}
+
+void i2c_stop(void) {
+    if (!cur_open) return;
+    mock_commit();
+    cur_open = 0;
+}
+
+/* ============================================
+ * REGISTRO
+ * ============================================ */
+
+void i2c_mock_reset(void) {
+    txn_count = 0;
+    byte_count = 0;
+    totals.starts = 0;
+    totals.bytes = 0;
+    totals.dropped = 0;
+    cur_open = 0;
+    cur_len = 0;
+}
+
+uint16_t i2c_mock_count(void) {
+    return txn_count;
+}
+
+const i2c_mock_txn *i2c_mock_get(uint16_t i) {
+    if (i >= txn_count) return 0;
+    return &txn_log[i];
+}
+
+const uint8_t *i2c_mock_data(const i2c_mock_txn *t) {
+    return &byte_log[t->offset];
+}
+
+const i2c_mock_totals *i2c_mock_get_totals(void) {
+    return &totals;
+}
+
+void i2c_mock_set_ack(uint8_t ack) {
+    ack_value = ack;
+}
+
+void i2c_mock_set_sink(i2c_mock_sink sink) {
+    sink_fn = sink;
+}
+
+void i2c_mock_dump(FILE *out) {
+    uint16_t i, j;
+    const i2c_mock_txn *t;
+    const uint8_t *d;
+    
+    for (i = 0; i < txn_count; i++) {
+        t = &txn_log[i];
+        d = &byte_log[t->offset];
+        fprintf(out, "%5u  addr=%02X %c len=%-4u", i, t->addr,
+                t->rw == I2C_READ ? 'R' : 'W', t->len);
+        for (j = 0; j < t->len && j < 24; j++) {
+            fprintf(out, " %02X", d[j]);
+        }
+        if (t->len > 24) fprintf(out, " ...");
+        fputc('\n', out);
+    }
+    fprintf(out, "# starts=%lu bytes=%lu dropped=%lu\n",
+            (unsigned long)totals.starts, (unsigned long)totals.bytes,
+            (unsigned long)totals.dropped);
+}
@@ -0,0 +1,85 @@
+/**
+ * i2c_mock.h - Backend I2C simulado para compilar en PC (gcc)
+ * 
+ * Implementa la misma interfaz que ../i2c/i2c.h del hardware
+ * (i2c_start / i2c_write_byte / i2c_stop) y registra cada transacción
+ * (dirección, byte de control y payload) para medir el tráfico del bus.
+ * 
+ * Se activa con SSD1306_HOST_MOCK=1 (el core incluye este header
+ * en lugar del driver I2C real).
+ */
+
+#ifndef I2C_MOCK_H
+#define I2C_MOCK_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef I2C_WRITE
+#define I2C_WRITE           0
+#endif
+#ifndef I2C_READ
+#define I2C_READ            1
+#endif
+
+/* Capacidad del registro (las transacciones extra se cuentan pero no se guardan) */
+#ifndef I2C_MOCK_MAX_TXN
+#define I2C_MOCK_MAX_TXN    8192
+#endif
+#ifndef I2C_MOCK_MAX_BYTES
+#define I2C_MOCK_MAX_BYTES  262144UL
+#endif
+
+/* ============================================
+ * INTERFAZ I2C (igual que el driver real)
+ * ============================================ */
+
+uint8_t i2c_start(uint8_t addr, uint8_t rw);
+uint8_t i2c_write_byte(uint8_t data);
+void i2c_stop(void);
+
+/* ============================================
+ * REGISTRO DE TRANSACCIONES
+ * ============================================ */
+
+/* Una transacción START ... STOP */
+typedef struct {
+    uint8_t  addr;      /* Dirección de 7 bits */
+    uint8_t  rw;        /* I2C_WRITE / I2C_READ */
+    uint16_t len;       /* Bytes tras la dirección (control + payload) */
+    uint32_t offset;    /* Posición del primer byte en el log */
+} i2c_mock_txn;
+
+/* Totales acumulados desde el último i2c_mock_reset() */
+typedef struct {
+    uint32_t starts;    /* Condiciones START (= transacciones) */
+    uint32_t bytes;     /* Bytes en el bus, incluida la dirección */
+    uint32_t dropped;   /* Transacciones no guardadas por falta de espacio */
+} i2c_mock_totals;
+
+/* Borrar registro y totales */
+void i2c_mock_reset(void);
+
+/* Número de transacciones guardadas */
+uint16_t i2c_mock_count(void);
+
+/* Transacción i (0 = la más antigua) */
+const i2c_mock_txn *i2c_mock_get(uint16_t i);
+
+/* Bytes de una transacción (control + payload) */
+const uint8_t *i2c_mock_data(const i2c_mock_txn *t);
+
+/* Totales acumulados */
+const i2c_mock_totals *i2c_mock_get_totals(void);
+
+/* Valor de ACK que devuelve i2c_start (1 = display presente, por defecto) */
+void i2c_mock_set_ack(uint8_t ack);
+
+/* Callback al cerrar cada transacción (p.ej. para el emulador GDDRAM) */
+typedef void (*i2c_mock_sink)(uint8_t addr, const uint8_t *data, uint16_t len);
+void i2c_mock_set_sink(i2c_mock_sink sink);
+
+/* Volcar el registro en texto: una línea por transacción */
+void i2c_mock_dump(FILE *out);
+
+#endif /* I2C_MOCK_H */
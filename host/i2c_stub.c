@@ -0,0 +1,29 @@
+/**
+ * i2c_stub.c - Driver I2C de prueba para sim65
+ * 
+ * Implementa la interfaz de ../i2c/i2c.h sin tocar hardware: cuenta
+ * transacciones y bytes y responde ACK al instante. Sustituye a i2c.c
+ * al enlazar host/bench_sim65.c, de modo que los ciclos medidos son
+ * solo los de la librería.
+ */
+
+#include "../../i2c/i2c.h"
+
+/* Bytes en el bus, incluida la dirección (lo lee bench_sim65.c) */
+unsigned long i2c_stub_bytes;
+
+uint8_t i2c_start(uint8_t addr, uint8_t rw) {
+    (void)addr;
+    (void)rw;
+    i2c_stub_bytes++;
+    return 1;
+}
+
+uint8_t i2c_write_byte(uint8_t data) {
+    (void)data;
+    i2c_stub_bytes++;
+    return 1;
+}
+
+void i2c_stop(void) {
+}
@@ -0,0 +1,305 @@
+/**
+ * ssd1306_emu.c - Emulador del controlador SSD1306 para PC
+ */
+
+#include <string.h>
+#include "ssd1306_emu.h"
+#include "i2c_mock.h"
+
+/* ============================================
+ * COMANDOS
+ * ============================================ */
+
+/* Número de argumentos de cada comando multi-byte */
+static uint8_t emu_cmd_args(uint8_t cmd) {
+    switch (cmd) {
+    case 0x20: case 0x81: case 0x8D: case 0xA8:
+    case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x26: case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+/* Ejecutar un comando con sus argumentos ya recibidos */
+static void emu_exec(ssd1306_emu *emu, uint8_t cmd, const uint8_t *a) {
+    if (cmd <= 0x0F) {
+        emu->col = (emu->col & 0xF0) | cmd;
+    } else if (cmd <= 0x1F) {
+        emu->col = (uint8_t)(((cmd & 0x07) << 4) | (emu->col & 0x0F));
+    } else if (cmd >= 0x40 && cmd <= 0x7F) {
+        emu->start_line = cmd & 0x3F;
+    } else if (cmd >= 0xB0 && cmd <= 0xB7) {
+        emu->page = cmd & 0x07;
+    } else {
+        switch (cmd) {
+        case 0x20: emu->mode = a[0] & 0x03; break;
+        case 0x21:
+            emu->col_start = a[0] & 0x7F;
+            emu->col_end = a[1] & 0x7F;
+            emu->col = emu->col_start;
+            break;
+        case 0x22:
+            emu->page_start = a[0] & 0x07;
+            emu->page_end = a[1] & 0x07;
+            emu->page = emu->page_start;
+            break;
+        case 0x26: case 0x27:
+            emu->scroll_cmd = cmd;
+            emu->scroll_start = a[1] & 0x07;
+            emu->scroll_speed = a[2] & 0x07;
+            emu->scroll_end = a[3] & 0x07;
+            emu->scroll_voffset = 0;
+            break;
+        case 0x29: case 0x2A:
+            emu->scroll_cmd = cmd;
+            emu->scroll_start = a[1] & 0x07;
+            emu->scroll_speed = a[2] & 0x07;
+            emu->scroll_end = a[3] & 0x07;
+            emu->scroll_voffset = a[4] & 0x3F;
+            break;
+        case 0x2E: emu->scroll_active = 0; break;
+        case 0x2F: emu->scroll_active = (emu->scroll_cmd != 0); break;
+        case 0x81: emu->contrast = a[0]; break;
+        case 0x8D: emu->charge_pump = a[0]; break;
+        case 0xA0: emu->seg_remap = 0; break;
+        case 0xA1: emu->seg_remap = 1; break;
+        case 0xA3: break;   /* Área de scroll vertical: solo se acepta */
+        case 0xA4: emu->entire_on = 0; break;
+        case 0xA5: emu->entire_on = 1; break;
+        case 0xA6: emu->invert = 0; break;
+        case 0xA7: emu->invert = 1; break;
+        case 0xA8: emu->mux = a[0] & 0x3F; break;
+        case 0xAE: emu->display_on = 0; break;
+        case 0xAF: emu->display_on = 1; break;
+        case 0xC0: emu->com_remap = 0; break;
+        case 0xC8: emu->com_remap = 1; break;
+        case 0xD3: emu->offset = a[0] & 0x3F; break;
+        case 0xDA: emu->com_pins = a[0]; break;
+        case 0xD5: case 0xD9: case 0xDB: case 0xE3: break;
+        default: emu->unknown_cmds++; break;
+        }
+    }
+}
+
+/* Recibir un byte de comando (o argumento de uno pendiente) */
+static void emu_cmd_byte(ssd1306_emu *emu, uint8_t b) {
+    emu->cmd_bytes++;
+    
+    if (emu->need) {
+        emu->args[emu->nargs++] = b;
+        if (emu->nargs == emu->need) {
+            emu->need = 0;
+            emu_exec(emu, emu->cmd, emu->args);
+        }
+        return;
+    }
+    
+    emu->need = emu_cmd_args(b);
+    if (emu->need) {
+        emu->cmd = b;
+        emu->nargs = 0;
+    } else {
+        emu_exec(emu, b, emu->args);
+    }
+}
+
+/* Escribir un byte en GDDRAM y avanzar los punteros según el modo */
+static void emu_data_byte(ssd1306_emu *emu, uint8_t b) {
+    emu->data_bytes++;
+    emu->ram[emu->page & 0x07][emu->col & 0x7F] = b;
+    
+    switch (emu->mode) {
+    case SSD1306_EMU_HORIZONTAL:
+        if (emu->col >= emu->col_end) {
+            emu->col = emu->col_start;
+            emu->page = (emu->page >= emu->page_end) ? emu->page_start : emu->page + 1;
+        } else {
+            emu->col++;
+        }
+        break;
+    case SSD1306_EMU_VERTICAL:
+        if (emu->page >= emu->page_end) {
+            emu->page = emu->page_start;
+            emu->col = (emu->col >= emu->col_end) ? emu->col_start : emu->col + 1;
+        } else {
+            emu->page++;
+        }
+        break;
+    default:
+        /* Modo página: la columna da la vuelta sin cambiar de página */
+        emu->col = (emu->col + 1) & 0x7F;
+        break;
+    }
+}
+
+/* ============================================
+ * API
+ * ============================================ */
+
+void ssd1306_emu_init(ssd1306_emu *emu, uint8_t addr, uint8_t width, uint8_t height) {
+    memset(emu, 0, sizeof(*emu));
+    emu->addr = addr;
+    emu->width = width;
+    emu->height = height;
+    emu->col_offset = (width < SSD1306_EMU_COLS && height == 48) ? 32 : 0;
+    
+    /* Valores de reset según datasheet */
+    emu->mode = SSD1306_EMU_PAGE;
+    emu->col_end = SSD1306_EMU_COLS - 1;
+    emu->page_end = SSD1306_EMU_PAGES - 1;
+    emu->mux = 63;
+    emu->com_pins = 0x12;
+    emu->contrast = 0x7F;
+}
+
+void ssd1306_emu_feed(ssd1306_emu *emu, const uint8_t *data, uint16_t len) {
+    uint16_t i = 0;
+    uint8_t ctrl;
+    
+    while (i < len) {
+        ctrl = data[i++];
+        if (ctrl & 0x80) {
+            /* Co=1: un solo byte y luego otro byte de control */
+            if (i < len) {
+                if (ctrl & 0x40) emu_data_byte(emu, data[i++]);
+                else emu_cmd_byte(emu, data[i++]);
+            }
+        } else {
+            /* Co=0: el resto de la transacción es del mismo tipo */
+            while (i < len) {
+                if (ctrl & 0x40) emu_data_byte(emu, data[i++]);
+                else emu_cmd_byte(emu, data[i++]);
+            }
+        }
+    }
+}
+
+/* Emuladores conectados al mock I2C */
+#define EMU_MAX_ATTACHED 4
+static ssd1306_emu *attached[EMU_MAX_ATTACHED];
+static uint8_t n_attached = 0;
+
+static void emu_sink(uint8_t addr, const uint8_t *data, uint16_t len) {
+    uint8_t i;
+    for (i = 0; i < n_attached; i++) {
+        if (attached[i]->addr == addr) {
+            ssd1306_emu_feed(attached[i], data, len);
+        }
+    }
+}
+
+void ssd1306_emu_attach(ssd1306_emu *emu) {
+    if (n_attached < EMU_MAX_ATTACHED) {
+        attached[n_attached++] = emu;
+    }
+    i2c_mock_set_sink(emu_sink);
+}
+
+void ssd1306_emu_detach_all(void) {
+    n_attached = 0;
+    i2c_mock_set_sink(0);
+}
+
+void ssd1306_emu_scroll_step(ssd1306_emu *emu, uint8_t steps) {
+    uint8_t p, c, tmp;
+    
+    if (!emu->scroll_active) return;
+    
+    while (steps--) {
+        for (p = emu->scroll_start; p <= emu->scroll_end && p < SSD1306_EMU_PAGES; p++) {
+            if (emu->scroll_cmd == 0x26 || emu->scroll_cmd == 0x29) {
+                /* Derecha */
+                tmp = emu->ram[p][SSD1306_EMU_COLS - 1];
+                for (c = SSD1306_EMU_COLS - 1; c > 0; c--) {
+                    emu->ram[p][c] = emu->ram[p][c - 1];
+                }
+                emu->ram[p][0] = tmp;
+            } else {
+                /* Izquierda */
+                tmp = emu->ram[p][0];
+                for (c = 0; c < SSD1306_EMU_COLS - 1; c++) {
+                    emu->ram[p][c] = emu->ram[p][c + 1];
+                }
+                emu->ram[p][SSD1306_EMU_COLS - 1] = tmp;
+            }
+        }
+        if (emu->scroll_voffset) {
+            emu->start_line = (emu->start_line + emu->scroll_voffset) & 0x3F;
+        }
+    }
+}
+
+/*
+ * Imagen visible. Referencia: A1 + C8 (la config de ssd1306_init) se ve
+ * derecha; A0 espeja en horizontal y C0 en vertical. Las filas más allá
+ * del multiplex quedan apagadas. Si la config de COM pins (0xDA bit 4)
+ * no coincide con el cableado del panel (alternativo en paneles de más
+ * de 32 filas), las filas salen entrelazadas como en el hardware.
+ */
+uint8_t ssd1306_emu_pixel(const ssd1306_emu *emu, uint8_t x, uint8_t y) {
+    uint8_t col, row, rows, ram_row, bit;
+    uint8_t native_alt = (emu->height > 32);
+    
+    if (x >= emu->width || y >= emu->height) return 0;
+    if (!emu->display_on) return 0;
+    
+    rows = emu->mux + 1;
+    row = emu->com_remap ? y : (uint8_t)(emu->height - 1 - y);
+    if (row >= rows) return 0;
+    if (((emu->com_pins >> 4) & 1) != native_alt) {
+        row = (row & 1) ? (uint8_t)(rows / 2 + row / 2) : (uint8_t)(row / 2);
+    }
+    
+    if (emu->entire_on) return 1;
+    
+    col = emu->seg_remap ? x : (uint8_t)(emu->width - 1 - x);
+    col += emu->col_offset;
+    ram_row = (row + emu->start_line + emu->offset) & 0x3F;
+    
+    bit = (emu->ram[ram_row >> 3][col & 0x7F] >> (ram_row & 0x07)) & 1;
+    return bit ^ emu->invert;
+}
+
+long ssd1306_emu_compare(const ssd1306_emu *a, const ssd1306_emu *b) {
+    uint8_t x, y;
+    
+    if (a->width != b->width || a->height != b->height) return -2;
+    for (y = 0; y < a->height; y++) {
+        for (x = 0; x < a->width; x++) {
+            if (ssd1306_emu_pixel(a, x, y) != ssd1306_emu_pixel(b, x, y)) {
+                return (long)y * a->width + x;
+            }
+        }
+    }
+    return -1;
+}
+
+void ssd1306_emu_write_pbm(const ssd1306_emu *emu, FILE *out) {
+    uint8_t x, y;
+    
+    fprintf(out, "P1\n%u %u\n", emu->width, emu->height);
+    for (y = 0; y < emu->height; y++) {
+        for (x = 0; x < emu->width; x++) {
+            fputc(ssd1306_emu_pixel(emu, x, y) ? '1' : '0', out);
+            if ((x & 63) == 63 || x == emu->width - 1) fputc('\n', out);
+        }
+    }
+}
+
+void ssd1306_emu_dump_ascii(const ssd1306_emu *emu, FILE *out) {
+    uint8_t x, y;
+    
+    for (y = 0; y < emu->height; y++) {
+        for (x = 0; x < emu->width; x++) {
+            fputc(ssd1306_emu_pixel(emu, x, y) ? '#' : '.', out);
+        }
+        fputc('\n', out);
+    }
+}
@@ -0,0 +1,108 @@
+/**
+ * ssd1306_emu.h - Emulador del controlador SSD1306 para PC
+ * 
+ * Ejecuta el flujo de comandos/datos que envía el driver (a través de
+ * host/i2c_mock.c) y mantiene la GDDRAM de 128x64 y el estado del
+ * controlador. Permite comprobar que dos formas de dibujar (p.ej. con
+ * y sin ventanas, Co-bit o flush diferencial) dejan los mismos píxeles.
+ * 
+ * Modelado:
+ *   - Modos de direccionamiento página / horizontal / vertical (0x20)
+ *   - Ventanas de columnas y páginas (0x21 / 0x22)
+ *   - Posición en modo página (0xB0-B7, 0x00-0x1F); como en el hardware
+ *     real, también mueven el puntero en modo horizontal
+ *   - Start line (0x40-0x7F), offset (0xD3), multiplex (0xA8), COM pins (0xDA)
+ *   - Remap de segmentos y COM (0xA0/A1, 0xC0/C8), inversión (0xA6/A7),
+ *     todo encendido (0xA4/A5), on/off (0xAE/AF), contraste (0x81)
+ *   - Scroll horizontal (0x26/0x27/0x29/0x2A/0x2E/0x2F/0xA3); el
+ *     desplazamiento se aplica con ssd1306_emu_scroll_step()
+ */
+
+#ifndef SSD1306_EMU_H
+#define SSD1306_EMU_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define SSD1306_EMU_COLS    128
+#define SSD1306_EMU_PAGES   8
+
+/* Modos de direccionamiento (argumento de 0x20) */
+#define SSD1306_EMU_HORIZONTAL  0
+#define SSD1306_EMU_VERTICAL    1
+#define SSD1306_EMU_PAGE        2
+
+typedef struct {
+    /* Panel */
+    uint8_t addr;           /* Dirección I2C que atiende */
+    uint8_t width;          /* Columnas visibles */
+    uint8_t height;         /* Filas visibles */
+    uint8_t col_offset;     /* Primera columna de GDDRAM visible (64x48: 32) */
+    
+    /* GDDRAM */
+    uint8_t ram[SSD1306_EMU_PAGES][SSD1306_EMU_COLS];
+    
+    /* Punteros y ventana */
+    uint8_t mode;
+    uint8_t col, page;
+    uint8_t col_start, col_end;
+    uint8_t page_start, page_end;
+    
+    /* Configuración de hardware */
+    uint8_t start_line;
+    uint8_t offset;
+    uint8_t mux;            /* Filas activas - 1 */
+    uint8_t com_pins;       /* Argumento de 0xDA */
+    uint8_t seg_remap;      /* 1 = A1 */
+    uint8_t com_remap;      /* 1 = C8 */
+    uint8_t contrast;
+    uint8_t invert;
+    uint8_t entire_on;
+    uint8_t display_on;
+    uint8_t charge_pump;
+    
+    /* Scroll */
+    uint8_t scroll_cmd;     /* 0x26, 0x27, 0x29, 0x2A (0 = ninguno) */
+    uint8_t scroll_start;
+    uint8_t scroll_end;
+    uint8_t scroll_speed;
+    uint8_t scroll_voffset;
+    uint8_t scroll_active;
+    
+    /* Parser de comandos multi-byte */
+    uint8_t cmd;            /* Comando pendiente de argumentos */
+    uint8_t args[6];
+    uint8_t nargs;          /* Argumentos recibidos */
+    uint8_t need;           /* Argumentos esperados */
+    
+    /* Contadores */
+    uint32_t cmd_bytes;
+    uint32_t data_bytes;
+    uint32_t unknown_cmds;
+} ssd1306_emu;
+
+/* Inicializar en estado de encendido (RAM a 0) */
+void ssd1306_emu_init(ssd1306_emu *emu, uint8_t addr, uint8_t width, uint8_t height);
+
+/* Procesar una transacción I2C completa (control + payload) */
+void ssd1306_emu_feed(ssd1306_emu *emu, const uint8_t *data, uint16_t len);
+
+/* Conectar al mock I2C: las transacciones a emu->addr se ejecutan aquí */
+void ssd1306_emu_attach(ssd1306_emu *emu);
+void ssd1306_emu_detach_all(void);
+
+/* Aplicar n pasos de scroll horizontal activo (rota las páginas en GDDRAM) */
+void ssd1306_emu_scroll_step(ssd1306_emu *emu, uint8_t steps);
+
+/* Píxel visible en (x, y) del panel, con remap, offset, inversión... (0/1) */
+uint8_t ssd1306_emu_pixel(const ssd1306_emu *emu, uint8_t x, uint8_t y);
+
+/* Comparar imagen visible. Retorna -1 si son iguales, -2 si el tamaño del
+ * panel no coincide, o el índice y*width+x del primer píxel distinto */
+long ssd1306_emu_compare(const ssd1306_emu *a, const ssd1306_emu *b);
+
+/* Volcar imagen visible como PBM (P1) o como texto ('#' / '.') */
+void ssd1306_emu_write_pbm(const ssd1306_emu *emu, FILE *out);
+void ssd1306_emu_dump_ascii(const ssd1306_emu *emu, FILE *out);
+
+#endif /* SSD1306_EMU_H */
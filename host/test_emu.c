@@ -0,0 +1,934 @@
+/**
+ * test_emu.c - Comprobar en el emulador que los caminos optimizados
+ *              pintan lo que deben
+ * 
+ * El driver dibuja en un panel emulado (opt). La imagen esperada se
+ * construye en el propio programa y se carga en otro panel (ref) con un
+ * flujo de bytes escrito a mano en modo página (0x20 0x02, B0+p, 00/10),
+ * sin pasar por el driver; luego se comparan los píxeles visibles. Así
+ * un error de posicionamiento del core no puede aparecer igual en ambos
+ * lados. Los dos paneles reciben la misma ssd1306_init() al empezar.
+ * 
+ * Las fuentes (5x7, BigFont, 24x32) se toman dibujando cada carácter
+ * suelto en (0, 0) de un tercer panel (cap) y copiando sus bytes a la
+ * imagen esperada en la posición que corresponda.
+ * 
+ * Cubre:
+ *   - Modelo de punteros del emulador con secuencias crudas
+ *   - ssd1306_clear, write_window, write_at, data_begin y window_begin
+ *   - Texto, números de ancho fijo y campos de texto
+ *   - fb_flush, fb_flush_dirty, fb_flush_step (también cortado a medias)
+ *     y, con FB_SHADOW, fb_flush por diferencias
+ *   - Rellenos por tramos, fb_text y, con FB_BAND, fb_render
+ *   - ssd1306_init_ex (arranque en caliente y encendido diferido)
+ *   - BigFont y dígitos 24x32, y sus campos con estado
+ *   - Con MULTI: dos displays, fb_flush_dirty_multi y el lienzo cv_*
+ * 
+ * Compilar desde el directorio que contiene ssd1306/:
+ * 
+ *   gcc -Issd1306/host/config -I. -o test_emu \
+ *       ssd1306/host/test_emu.c ssd1306/host/i2c_mock.c \
+ *       ssd1306/host/ssd1306_emu.c \
+ *       ssd1306/core/ssd1306_*.c ssd1306/transport/ssd1306_*.c \
+ *       ssd1306/fonts/font_*.c \
+ *       ssd1306/text/ssd1306_*.c ssd1306/numbers/ssd1306_*.c \
+ *       ssd1306/graphics/ssd1306_*.c ssd1306/scroll/ssd1306_*.c \
+ *       ssd1306/framebuffer/ssd1306_*.c ssd1306/bignum/ssd1306_*.c
+ * 
+ * Con -Issd1306/host/config_multi se prueban MULTI y el lienzo, y con
+ * -Issd1306/host/config_band el framebuffer por bandas. Con host/config
+ * se puede añadir -DSSD1306_USE_FB_SHADOW=1 para el shadow, y con
+ * cualquiera -DSSD1306_PANEL=SSD1306_PANEL_128X64 para 64 filas.
+ * 
+ * Uso: ./test_emu       retorna 0 si todos los casos coinciden
+ *      ./test_emu -a    además, mostrar ambas pantallas en cada fallo
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <ssd1306/ssd1306.h>
+#include "i2c_mock.h"
+#include "ssd1306_emu.h"
+
+#define NO_ADDR     0x00    /* Dirección que no usa el driver */
+#define IMG_SIZE    ((uint16_t)SSD1306_WIDTH * SSD1306_PAGES)
+
+static ssd1306_emu opt;     /* Lo que dibuja el driver */
+static ssd1306_emu ref;     /* Imagen esperada (solo flujos crudos) */
+static ssd1306_emu cap;     /* Captura de caracteres sueltos */
+static int show_screen = 0;
+static int failures = 0;
+static uint8_t img[IMG_SIZE];
+static uint8_t pat[IMG_SIZE];
+
+#if SSD1306_USE_MULTI
+static ssd1306_emu opt2;    /* Segundo display, en SSD1306_ADDR + 1 */
+static ssd1306_dev dev2;
+static uint8_t fb2[IMG_SIZE];
+static uint8_t img2[IMG_SIZE];
+#endif
+
+/* ============================================
+ * RESULTADOS
+ * ============================================ */
+
+static void result(int ok, const char *name) {
+    if (ok) {
+        printf("ok     %s\n", name);
+    } else {
+        printf("FALLO  %s\n", name);
+        failures++;
+    }
+}
+
+/* Comparar un panel del driver con ref */
+static void check(const ssd1306_emu *e, const char *name) {
+    long diff = ssd1306_emu_compare(e, &ref);
+    
+    if (diff == -1) {
+        result(1, name);
+        return;
+    }
+    failures++;
+    if (diff == -2) {
+        printf("FALLO  %s: paneles de distinto tamaño\n", name);
+    } else {
+        printf("FALLO  %s: primer píxel distinto en (%ld, %ld)\n", name,
+               diff % e->width, diff / e->width);
+    }
+    if (show_screen) {
+        printf("driver:\n");
+        ssd1306_emu_dump_ascii(e, stdout);
+        printf("esperado:\n");
+        ssd1306_emu_dump_ascii(&ref, stdout);
+    }
+}
+
+/* ============================================
+ * FLUJOS CRUDOS (sin el driver)
+ * ============================================ */
+
+/* Enviar n comandos en una transacción (control 0x00) */
+static void feed_cmds(ssd1306_emu *e, const uint8_t *cmds, uint8_t n) {
+    uint8_t tx[16];
+    
+    tx[0] = 0x00;
+    memcpy(&tx[1], cmds, n);
+    ssd1306_emu_feed(e, tx, n + 1);
+}
+
+/* Enviar n bytes de datos (control 0x40) */
+static void feed_data(ssd1306_emu *e, const uint8_t *data, uint8_t n) {
+    uint8_t tx[1 + 128];
+    
+    tx[0] = 0x40;
+    memcpy(&tx[1], data, n);
+    ssd1306_emu_feed(e, tx, n + 1);
+}
+
+/*
+ * Cargar una imagen completa en modo página: cada página se posiciona
+ * con B0+p / 00 / 10 y recibe sus WIDTH bytes. Deja el panel en modo
+ * horizontal, como lo espera el driver.
+ */
+static void load_image(ssd1306_emu *e, const uint8_t *data) {
+    static const uint8_t page_mode[2] = { 0x20, 0x02 };
+    static const uint8_t horizontal[2] = { 0x20, 0x00 };
+    uint8_t pos[3];
+    uint8_t page;
+    
+    feed_cmds(e, page_mode, 2);
+    for (page = 0; page < SSD1306_PAGES; page++) {
+        pos[0] = 0xB0 + page;
+        pos[1] = e->col_offset & 0x0F;
+        pos[2] = 0x10 | (e->col_offset >> 4);
+        feed_cmds(e, pos, 3);
+        feed_data(e, &data[(uint16_t)page * SSD1306_WIDTH], SSD1306_WIDTH);
+    }
+    feed_cmds(e, horizontal, 2);
+}
+
+/* ============================================
+ * DESTINO DEL BUS
+ * ============================================ */
+
+/*
+ * Dirigir el tráfico del driver a opt o a cap. Antes se deja la ventana
+ * completa en los dos: el driver recuerda una sola ventana y no debe
+ * quedar una reducida en el panel que deja de escuchar.
+ */
+static void route(ssd1306_emu *e) {
+#if SSD1306_USE_MULTI
+    ssd1306_select(&ssd1306_default);
+#endif
+    opt.addr = SSD1306_ADDR;
+    cap.addr = SSD1306_ADDR;
+    ssd1306_set_window(0, SSD1306_WIDTH - 1, 0, SSD1306_PAGES - 1);
+    if (e != &opt) opt.addr = NO_ADDR;
+    if (e != &cap) cap.addr = NO_ADDR;
+}
+
+/* Dejar los paneles del driver y la imagen esperada en blanco */
+static void blank(void) {
+    memset(img, 0, IMG_SIZE);
+    load_image(&opt, img);
+#if SSD1306_USE_MULTI
+    memset(img2, 0, IMG_SIZE);
+    load_image(&opt2, img2);
+#endif
+    route(&opt);
+#if SSD1306_USE_FB_DIRTY || SSD1306_USE_FB_SHADOW
+    fb_invalidate();
+#endif
+}
+
+/* ============================================
+ * IMAGEN ESPERADA
+ * ============================================ */
+
+/* Patrón que no se repite en una página */
+static void fill_pattern(uint8_t *data, uint16_t n, uint8_t seed) {
+    uint16_t i;
+    
+    for (i = 0; i < n; i++) {
+        data[i] = (uint8_t)(i * 37 + seed);
+    }
+}
+
+/* Poner w columnas x pages páginas de data en (col, page) */
+static void put_bytes(uint8_t *buf, uint8_t col, uint8_t page,
+                      uint8_t w, uint8_t pages, const uint8_t *data) {
+    uint8_t c, p;
+    
+    for (p = 0; p < pages; p++) {
+        for (c = 0; c < w; c++) {
+            buf[(uint16_t)(page + p) * SSD1306_WIDTH + col + c] = *data++;
+        }
+    }
+}
+
+/* Empezar una captura en cap (borrado) */
+static void cap_begin(void) {
+    route(&cap);
+    memset(cap.ram, 0, sizeof(cap.ram));
+}
+
+/* Copiar w columnas x pages páginas de (0, 0) de cap a (x, page), con recorte */
+static void put_cap(uint8_t *buf, int x, uint8_t page, uint8_t w, uint8_t pages) {
+    uint8_t c, p;
+    
+    for (p = 0; p < pages && page + p < SSD1306_PAGES; p++) {
+        for (c = 0; c < w; c++) {
+            if (x + c < 0 || x + c >= SSD1306_WIDTH) continue;
+            buf[(uint16_t)(page + p) * SSD1306_WIDTH + x + c] = cap.ram[p][cap.col_offset + c];
+        }
+    }
+}
+
+#if SSD1306_USE_TEXT
+/* Columnas de un carácter 5x7, con su columna de espacio */
+static uint8_t glyph_cols(char c, uint8_t *cols) {
+    uint8_t w = font_get_width() + 1;
+    
+    cap_begin();
+    ssd1306_char(0, 0, c);
+    route(&opt);
+    memcpy(cols, &cap.ram[0][cap.col_offset], w);
+    return w;
+}
+
+/* Texto 5x7 en (col, page) */
+static void expect_text(uint8_t *buf, int col, uint8_t page, const char *str) {
+    uint8_t w = font_get_width() + 1;
+    
+    while (*str) {
+        cap_begin();
+        ssd1306_char(0, 0, *str++);
+        route(&opt);
+        put_cap(buf, col, page, w, 1);
+        col += w;
+    }
+}
+#endif
+
+/* Píxel con recorte, en los modos de fb_fill_rect */
+static void img_pixel(uint8_t *buf, int x, int y, uint8_t mode) {
+    uint8_t *p;
+    uint8_t bit;
+    
+    if (x < 0 || y < 0 || x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) return;
+    p = &buf[(uint16_t)(y >> 3) * SSD1306_WIDTH + x];
+    bit = 1 << (y & 7);
+    switch (mode) {
+        case FB_CLEAR: *p &= ~bit; break;
+        case FB_XOR:   *p ^= bit;  break;
+        default:       *p |= bit;  break;
+    }
+}
+
+static void model_rect(uint8_t *buf, int x, int y, int w, int h, uint8_t mode) {
+    int i, j;
+    
+    for (j = y; j < y + h; j++) {
+        for (i = x; i < x + w; i++) {
+            img_pixel(buf, i, j, mode);
+        }
+    }
+}
+
+/* Círculo relleno: mismo trazado midpoint, tramos píxel a píxel */
+static void model_circle_filled(uint8_t *buf, int cx, int cy, int r) {
+    int x = 0;
+    int y = r;
+    int d = 1 - r;
+    
+    model_rect(buf, cx - y, cy, 2 * y + 1, 1, FB_OR);
+    while (x < y) {
+        if (d < 0) {
+            d += 2 * x + 3;
+        } else {
+            d += 2 * (x - y) + 5;
+            y--;
+        }
+        x++;
+        model_rect(buf, cx - x, cy + y, 2 * x + 1, 1, FB_OR);
+        model_rect(buf, cx - x, cy - y, 2 * x + 1, 1, FB_OR);
+        model_rect(buf, cx - y, cy + x, 2 * y + 1, 1, FB_OR);
+        model_rect(buf, cx - y, cy - x, 2 * y + 1, 1, FB_OR);
+    }
+}
+
+#if SSD1306_USE_FB_TEXT
+/* Texto 5x7 en cualquier y, píxel a píxel (FB_OPAQUE borra el fondo) */
+static void model_text(uint8_t *buf, int x, int y, const char *str, uint8_t mode) {
+    uint8_t cols[8];
+    uint8_t w, c, row;
+    
+    while (*str && x < SSD1306_WIDTH) {
+        w = glyph_cols(*str++, cols);
+        for (c = 0; c < w; c++, x++) {
+            for (row = 0; row < 8; row++) {
+                if ((cols[c] >> row) & 1) {
+                    img_pixel(buf, x, y + row, (mode == FB_OPAQUE) ? FB_OR : mode);
+                } else if (mode == FB_OPAQUE) {
+                    img_pixel(buf, x, y + row, FB_CLEAR);
+                }
+            }
+        }
+    }
+}
+#endif
+
+/* ============================================
+ * EMULADOR
+ * ============================================ */
+
+static int ram_is(const ssd1306_emu *e, uint8_t page, uint8_t col,
+                  const uint8_t *vals, uint8_t n) {
+    uint8_t i;
+    
+    for (i = 0; i < n; i++) {
+        if (e->ram[page][(col + i) & 0x7F] != vals[i]) return 0;
+    }
+    return 1;
+}
+
+/* Secuencias crudas con resultado conocido en la GDDRAM */
+static void test_emu_model(void) {
+    static ssd1306_emu e;
+    static const uint8_t horiz[] = { 0x20, 0x00, 0x21, 10, 12, 0x22, 1, 2 };
+    static const uint8_t vert[] = { 0x20, 0x01, 0x21, 20, 21, 0x22, 4, 6 };
+    static const uint8_t page[] = { 0x20, 0x02, 0xB3, 0x0E, 0x17 };
+    static const uint8_t hpos[] = { 0x20, 0x00, 0x21, 0, 127, 0x22, 0, 7, 0xB5, 0x0E, 0x17 };
+    static const uint8_t data[] = { 1, 2, 3, 4, 5, 6, 7 };
+    static const uint8_t h1[] = { 7, 2, 3 };
+    static const uint8_t h2[] = { 4, 5, 6 };
+    int ok;
+    
+    /* Horizontal en ventana 10-12 x 1-2: el 7º byte vuelve al inicio */
+    ssd1306_emu_init(&e, SSD1306_ADDR, 128, 64);
+    feed_cmds(&e, horiz, sizeof(horiz));
+    feed_data(&e, data, 7);
+    ok = ram_is(&e, 1, 10, h1, 3) && ram_is(&e, 2, 10, h2, 3);
+    result(ok, "emulador: modo horizontal con ventana");
+    
+    /* Vertical en ventana 20-21 x 4-6: columna a columna */
+    ssd1306_emu_init(&e, SSD1306_ADDR, 128, 64);
+    feed_cmds(&e, vert, sizeof(vert));
+    feed_data(&e, data, 6);
+    ok = e.ram[4][20] == 1 && e.ram[5][20] == 2 && e.ram[6][20] == 3 &&
+         e.ram[4][21] == 4 && e.ram[5][21] == 5 && e.ram[6][21] == 6;
+    result(ok, "emulador: modo vertical con ventana");
+    
+    /* Página 3, columna 0x7E: la columna da la vuelta en la misma página */
+    ssd1306_emu_init(&e, SSD1306_ADDR, 128, 64);
+    feed_cmds(&e, page, sizeof(page));
+    feed_data(&e, data, 3);
+    ok = ram_is(&e, 3, 126, data, 3) && e.ram[4][0] == 0;
+    result(ok, "emulador: modo página");
+    
+    /* B0+p / 00 / 10 en modo horizontal: sigue en la página siguiente */
+    ssd1306_emu_init(&e, SSD1306_ADDR, 128, 64);
+    feed_cmds(&e, hpos, sizeof(hpos));
+    feed_data(&e, data, 3);
+    ok = ram_is(&e, 5, 126, data, 2) && e.ram[6][0] == 3 && e.ram[5][0] == 0;
+    result(ok, "emulador: posición de página en modo horizontal");
+}
+
+/* ============================================
+ * CORE
+ * ============================================ */
+
+static void test_clear(void) {
+    route(&opt);
+    fill_pattern(img, IMG_SIZE, 1);
+    load_image(&opt, img);
+    ssd1306_clear();
+    memset(img, 0, IMG_SIZE);
+    load_image(&ref, img);
+    check(&opt, "ssd1306_clear");
+}
+
+static void test_position(void) {
+    uint8_t i;
+    
+    blank();
+    fill_pattern(pat, 3 * 40, 7);
+    
+    ssd1306_write_window(50, 0, 40, 3, pat);
+    put_bytes(img, 50, 0, 40, 3, pat);
+    
+    ssd1306_write_at(5, SSD1306_PAGES - 1, pat, 30);
+    put_bytes(img, 5, SSD1306_PAGES - 1, 30, 1, pat);
+    
+    /* Hasta la última columna de la página */
+    ssd1306_data_begin(SSD1306_WIDTH - 8, 1);
+    ssd1306_data_buf(pat + 40, 8);
+    ssd1306_data_end();
+    put_bytes(img, SSD1306_WIDTH - 8, 1, 8, 1, pat + 40);
+    
+    /* Ventana de 3 x 2 y, tras ella, una escritura posicionada */
+    ssd1306_window_begin(7, 9, 1, 2);
+    for (i = 0; i < 6; i++) {
+        ssd1306_data_put(pat[80 + i]);
+    }
+    ssd1306_data_end();
+    put_bytes(img, 7, 1, 3, 2, pat + 80);
+    ssd1306_write_at(20, 2, pat, 4);
+    put_bytes(img, 20, 2, 4, 1, pat);
+    
+    load_image(&ref, img);
+    check(&opt, "write_window / write_at / data_begin / window_begin");
+}
+
+#if SSD1306_USE_INIT_EX
+static void test_init_ex(void) {
+    static const uint8_t garbage[] = { 0x20, 0x01, 0x21, 3, 4, 0x22, 1, 1, 0xAE };
+    int ok;
+    
+    /* En caliente: conserva la GDDRAM y deja modo horizontal y ventana completa */
+    blank();
+    fill_pattern(img, IMG_SIZE, 3);
+    load_image(&opt, img);
+    feed_cmds(&opt, garbage, sizeof(garbage));
+    ssd1306_init_ex(SSD1306_INIT_WARM);
+    ok = opt.mode == SSD1306_EMU_HORIZONTAL && opt.display_on &&
+         opt.col_start == opt.col_offset &&
+         opt.col_end == opt.col_offset + SSD1306_WIDTH - 1 &&
+         opt.page_start == 0 && opt.page_end == SSD1306_PAGES - 1;
+    result(ok, "ssd1306_init_ex(WARM): modo, ventana y encendido");
+    ssd1306_write_at(0, 0, pat, 4);
+    put_bytes(img, 0, 0, 4, 1, pat);
+    load_image(&ref, img);
+    check(&opt, "ssd1306_init_ex(WARM): GDDRAM conservada");
+    
+#if !SSD1306_USE_FB_BAND
+    /* Encendido diferido hasta el primer flush */
+    ssd1306_init_ex(SSD1306_INIT_DEFER_ON);
+    ok = !opt.display_on;
+    fb_clear();
+    fb_flush();
+    ok = ok && opt.display_on;
+    result(ok, "ssd1306_init_ex(DEFER_ON): enciende en el primer flush");
+#endif
+}
+#endif
+
+/* ============================================
+ * TEXTO Y NÚMEROS
+ * ============================================ */
+#if SSD1306_USE_TEXT
+static void test_text(void) {
+#if SSD1306_USE_TEXT_FIELD
+    ssd1306_field field;
+#endif
+    
+    blank();
+    ssd1306_text(0, 0, "Hola 123");
+    expect_text(img, 0, 0, "Hola 123");
+#if SSD1306_USE_NUMBERS
+    ssd1306_number_fixed(0, 1, 1234, 7, 2, 0);
+    expect_text(img, 0, 1, "  12.34");
+    ssd1306_number_fixed(48, 1, (uint16_t)-5, 5, 0, SSD1306_NUM_SIGNED | SSD1306_NUM_ZERO);
+    expect_text(img, 48, 1, "-0005");
+    ssd1306_number_signed(96, 1, -15);
+    expect_text(img, 96, 1, "-15");
+#endif
+#if SSD1306_USE_NUMBERS_32
+    ssd1306_number_fixed32(0, 2, 1234567UL, 9, 3, 0);
+    expect_text(img, 0, 2, " 1234.567");
+#endif
+#if SSD1306_USE_NUMBERS_HEX
+    ssd1306_hex16(80, 2, 0xCAFE);
+    expect_text(img, 80, 2, "CAFE");
+#endif
+#if SSD1306_USE_TEXT_FIELD
+    ssd1306_field_init(&field, 6, SSD1306_PAGES - 1, 8);
+    ssd1306_field_set(&field, "abc");
+    ssd1306_field_set(&field, "abd12");
+    ssd1306_field_set(&field, "x");
+    expect_text(img, 6, SSD1306_PAGES - 1, "x       ");
+#endif
+    load_image(&ref, img);
+    check(&opt, "texto, números y campo de texto");
+}
+#endif
+
+/* ============================================
+ * FRAMEBUFFER
+ * ============================================ */
+
+/* Escena de rellenos con recortes en los cuatro bordes */
+static void spans_fb(void) {
+    fb_rect_filled(3, 2, 40, 13);
+    fb_hline(0, SSD1306_HEIGHT / 2, SSD1306_WIDTH);
+    fb_vline(100, 1, SSD1306_HEIGHT - 2);
+    fb_fill_rect(20, 5, 60, SSD1306_HEIGHT - 9, FB_XOR);
+    fb_fill_rect(50, 0, 10, SSD1306_HEIGHT, FB_CLEAR);
+    fb_fill_rect(SSD1306_WIDTH - 7, SSD1306_HEIGHT - 5, 20, 20, FB_OPAQUE);
+    fb_circle_filled(80, SSD1306_HEIGHT / 2, 11);
+    fb_circle_filled(4, SSD1306_HEIGHT - 3, 9);
+    fb_circle_filled(-2, 3, 6);
+}
+
+static void spans_model(uint8_t *buf) {
+    model_rect(buf, 3, 2, 40, 13, FB_OR);
+    model_rect(buf, 0, SSD1306_HEIGHT / 2, SSD1306_WIDTH, 1, FB_OR);
+    model_rect(buf, 100, 1, 1, SSD1306_HEIGHT - 2, FB_OR);
+    model_rect(buf, 20, 5, 60, SSD1306_HEIGHT - 9, FB_XOR);
+    model_rect(buf, 50, 0, 10, SSD1306_HEIGHT, FB_CLEAR);
+    model_rect(buf, SSD1306_WIDTH - 7, SSD1306_HEIGHT - 5, 20, 20, FB_OR);
+    model_circle_filled(buf, 80, SSD1306_HEIGHT / 2, 11);
+    model_circle_filled(buf, 4, SSD1306_HEIGHT - 3, 9);
+    model_circle_filled(buf, -2, 3, 6);
+}
+
+#if SSD1306_USE_FB_TEXT
+/* Texto en y no alineada, en los cuatro modos y cortado por los bordes */
+static void text_fb(void) {
+    fb_fill_rect(0, 8, 60, 16, FB_OR);
+    fb_text(2, 3, "Ab1", FB_OR);
+    fb_text(4, 12, "xor", FB_XOR);
+    fb_text(30, 18, "op", FB_OPAQUE);
+    fb_text(40, 9, "cl", FB_CLEAR);
+    fb_text(SSD1306_WIDTH - 10, SSD1306_HEIGHT - 6, "cut", FB_OR);
+}
+
+static void text_model(uint8_t *buf) {
+    model_rect(buf, 0, 8, 60, 16, FB_OR);
+    model_text(buf, 2, 3, "Ab1", FB_OR);
+    model_text(buf, 4, 12, "xor", FB_XOR);
+    model_text(buf, 30, 18, "op", FB_OPAQUE);
+    model_text(buf, 40, 9, "cl", FB_CLEAR);
+    model_text(buf, SSD1306_WIDTH - 10, SSD1306_HEIGHT - 6, "cut", FB_OR);
+}
+#endif
+
+#if SSD1306_USE_FB_BAND
+/* Las dos escenas, dibujadas banda a banda */
+static void band_scene(void) {
+    spans_fb();
+#if SSD1306_USE_FB_TEXT
+    text_fb();
+#endif
+}
+
+static void test_band(void) {
+    blank();
+    fb_render(band_scene);
+    spans_model(img);
+#if SSD1306_USE_FB_TEXT
+    text_model(img);
+#endif
+    load_image(&ref, img);
+    check(&opt, "fb_render por bandas");
+}
+#else
+
+/* Tras un flush, opt debe mostrar el contenido del framebuffer */
+static void check_fb(const char *name) {
+    load_image(&ref, fb_get_buffer());
+    check(&opt, name);
+}
+
+static void test_spans(void) {
+    blank();
+    fb_clear();
+    spans_fb();
+    fb_flush();
+    spans_model(img);
+    load_image(&ref, img);
+    check(&opt, "fb_fill_rect / fb_circle_filled + fb_flush");
+    
+#if SSD1306_USE_FB_DIRTY
+    /* Los tramos marcan bien las columnas sucias */
+    blank();
+    fb_clear();
+    fb_flush();
+    spans_fb();
+    fb_flush_dirty();
+    spans_model(img);
+    load_image(&ref, img);
+    check(&opt, "fb_fill_rect / fb_circle_filled + fb_flush_dirty");
+#endif
+    
+#if SSD1306_USE_FB_TEXT
+    blank();
+    fb_clear();
+    text_fb();
+    fb_flush();
+    text_model(img);
+    load_image(&ref, img);
+    check(&opt, "fb_text en los cuatro modos");
+#endif
+}
+
+/* Flushes parciales sobre una pantalla ya enviada */
+static void test_flushes(void) {
+    blank();
+    fb_clear();
+    fb_rect(2, 2, 30, 9);
+    fb_circle(90, SSD1306_HEIGHT / 2, 12);
+    fb_flush();
+    check_fb("fb_flush");
+    
+#if SSD1306_USE_FB_DIRTY
+    fb_set_pixel(0, 0);
+    fb_set_pixel(SSD1306_WIDTH - 1, SSD1306_HEIGHT - 1);
+    fb_fill_rect(60, 3, 9, 10, FB_XOR);
+    fb_line(0, SSD1306_HEIGHT - 1, 40, 0);
+    fb_flush_dirty();
+    check_fb("fb_flush_dirty");
+#endif
+    
+#if SSD1306_USE_FB_SHADOW
+    fb_clear_pixel(0, 0);
+    fb_fill_rect(10, SSD1306_HEIGHT - 6, 30, 4, FB_OR);
+    fb_toggle_pixel(SSD1306_WIDTH - 1, 0);
+    fb_flush();
+    check_fb("fb_flush (shadow)");
+#endif
+    
+#if SSD1306_USE_FB_ASYNC
+    fb_fill_rect(30, 0, 50, SSD1306_HEIGHT, FB_XOR);
+    fb_flush_begin();
+    while (fb_flush_step(32)) { }
+    check_fb("fb_flush_step(32)");
+#endif
+}
+
+#if SSD1306_USE_FB_ASYNC
+/*
+ * Cortar un flush incremental a mitad de la página 0: lo que quedaba
+ * de ella no puede perderse ni llegar después con contenido viejo.
+ */
+static void async_start(void) {
+    blank();
+    fb_clear();
+    fb_flush();
+    fb_fill_rect(0, 0, SSD1306_WIDTH, 8, FB_OR);
+    fb_flush_begin();
+    fb_flush_step(10);
+}
+
+static void test_async_cancel(void) {
+    /* Reinicio */
+    async_start();
+    fb_fill_rect(10, 17, 30, 3, FB_OR);
+    fb_flush_begin();
+    while (fb_flush_step(32)) { }
+    check_fb("fb_flush_begin a mitad de flush");
+    
+    /* Cancelado por fb_flush */
+    async_start();
+    fb_flush();
+    while (fb_flush_step(32)) { }
+    check_fb("fb_flush a mitad de flush");
+    
+#if SSD1306_USE_FB_DIRTY
+    /* Cancelado por fb_flush_dirty, con dibujo posterior en la página */
+    async_start();
+    fb_fill_rect(60, 0, 20, 8, FB_CLEAR);
+    fb_flush_dirty();
+    result(!fb_flush_busy(), "fb_flush_dirty cancela el flush incremental");
+    while (fb_flush_step(32)) { }
+    check_fb("fb_flush_dirty a mitad de flush");
+#endif
+}
+#endif
+#endif /* SSD1306_USE_FB_BAND */
+
+/* ============================================
+ * BIGFONT Y DÍGITOS 24x32
+ * ============================================ */
+#if SSD1306_USE_BIGNUM
+/* BigFont: cada carácter capturado suelto */
+static void expect_bigtext(uint8_t *buf, int x, uint8_t page, const char *str) {
+    while (*str) {
+        cap_begin();
+        ssd1306_bigchar(0, 0, *str++);
+        route(&opt);
+        put_cap(buf, x, page, BIGFONT_CHAR_W, 2);
+        x += BIGFONT_CHAR_W + BIGFONT_SPACING;
+    }
+}
+
+static void test_bigfont(void) {
+    ssd1306_bigfield field;
+    
+    blank();
+    ssd1306_bigtext(3, BIGFONT_ROW1, "12:34");
+    expect_bigtext(img, 3, BIGFONT_ROW1, "12:34");
+    ssd1306_bignum_number(0, BIGFONT_ROW1 + 2, 907, 4);
+    expect_bigtext(img, 0, BIGFONT_ROW1 + 2, "0907");
+    ssd1306_bigtext(SSD1306_WIDTH - 20, BIGFONT_ROW1 + 2, "AB");
+    expect_bigtext(img, SSD1306_WIDTH - 20, BIGFONT_ROW1 + 2, "AB");
+    load_image(&ref, img);
+    check(&opt, "ssd1306_bigtext / bignum_number");
+    
+    blank();
+    ssd1306_bigfield_init(&field, 10, BIGFONT_ROW1);
+    ssd1306_bigfield_time(&field, 12, 59);
+    ssd1306_bigfield_time(&field, 13, 0);
+    ssd1306_bigfield_time(&field, 13, 1);
+    expect_bigtext(img, 10, BIGFONT_ROW1, "13:01");
+    load_image(&ref, img);
+    check(&opt, "ssd1306_bigfield_time");
+}
+#endif
+
+#if SSD1306_USE_BIGNUM24
+/* Dígitos 24x32 y ':': cada celda capturada suelta */
+static void expect_big24(uint8_t *buf, int x, const char *str) {
+    uint8_t w;
+    
+    while (*str) {
+        cap_begin();
+        if (*str == ':') {
+            ssd1306_bignum24_colon(0);
+            w = 8;
+        } else {
+            ssd1306_bignum24_digit(0, *str - '0');
+            w = BIGNUM_WIDTH;
+        }
+        route(&opt);
+        put_cap(buf, x, 0, w, BIGNUM_HEIGHT);
+        x += w + BIGNUM_SPACING;
+        str++;
+    }
+}
+
+static void test_bignum24(void) {
+    ssd1306_bigfield24 field;
+    
+    blank();
+    ssd1306_bignum24_time(0, 12, 34);
+    expect_big24(img, 0, "12:34");
+    load_image(&ref, img);
+    check(&opt, "ssd1306_bignum24_time");
+    
+    blank();
+    ssd1306_bignum24_number(10, 4071, 4);
+    expect_big24(img, 10, "4071");
+    load_image(&ref, img);
+    check(&opt, "ssd1306_bignum24_number (recortado)");
+    
+    blank();
+    ssd1306_bigfield24_init(&field, 0);
+#if SSD1306_USE_TEXT
+    ssd1306_bigfield24_time_full(&field, 9, 59, 58);
+    ssd1306_bigfield24_time_full(&field, 9, 59, 59);
+    ssd1306_bigfield24_time_full(&field, 10, 0, 0);
+    expect_big24(img, 0, "10:00");
+    expect_text(img, 4 * BIGNUM_WIDTH + 8 + 4 * BIGNUM_SPACING + 4, BIGNUM_HEIGHT - 1, "00");
+    load_image(&ref, img);
+    check(&opt, "ssd1306_bigfield24_time_full");
+#else
+    ssd1306_bigfield24_time(&field, 9, 59);
+    ssd1306_bigfield24_time(&field, 10, 0);
+    expect_big24(img, 0, "10:00");
+    load_image(&ref, img);
+    check(&opt, "ssd1306_bigfield24_time");
+#endif
+}
+#endif
+
+/* ============================================
+ * VARIOS DISPLAYS
+ * ============================================ */
+#if SSD1306_USE_MULTI
+static void test_multi(void) {
+    static ssd1306_dev * const devs[2] = { &ssd1306_default, &dev2 };
+    
+    blank();
+    fb_clear();
+    fb_rect_filled(3, 2, 40, 13);
+    ssd1306_select(&dev2);
+    fb_invalidate();
+    fb_clear();
+    fb_circle_filled(64, SSD1306_HEIGHT / 2, 10);
+    fb_fill_rect(0, 0, 20, 8, FB_XOR);
+    fb_flush_dirty_multi(devs, 2);
+    result(ssd1306_cur == &dev2, "fb_flush_dirty_multi conserva la selección");
+    
+    model_rect(img, 3, 2, 40, 13, FB_OR);
+    model_circle_filled(img2, 64, SSD1306_HEIGHT / 2, 10);
+    model_rect(img2, 0, 0, 20, 8, FB_XOR);
+    load_image(&ref, img);
+    check(&opt, "fb_flush_dirty_multi: display 1");
+    load_image(&ref, img2);
+    check(&opt2, "fb_flush_dirty_multi: display 2");
+    
+    /* Texto directo al segundo display: el primero no cambia */
+    ssd1306_dev_text(&dev2, 0, 0, "dev2");
+    expect_text(img2, 0, 0, "dev2");
+    load_image(&ref, img);
+    check(&opt, "ssd1306_dev_text: display 1 intacto");
+    load_image(&ref, img2);
+    check(&opt2, "ssd1306_dev_text: display 2");
+}
+
+#if SSD1306_USE_FB_CANVAS && SSD1306_CANVAS_TILES == 2
+/* Píxel del lienzo en la imagen del panel que lo contiene */
+static void cv_model_pixel(int x, int y, uint8_t mode) {
+    uint8_t tile = (uint8_t)((y / SSD1306_HEIGHT) * SSD1306_CANVAS_COLS + x / SSD1306_WIDTH);
+    
+    img_pixel(tile ? img2 : img, x % SSD1306_WIDTH, y % SSD1306_HEIGHT, mode);
+}
+
+static void cv_model_rect(int x, int y, int w, int h) {
+    int i, j;
+    
+    for (j = y; j < y + h; j++) {
+        for (i = x; i < x + w; i++) {
+            cv_model_pixel(i, j, FB_OR);
+        }
+    }
+}
+
+/* Texto del lienzo: opaco en sus 8 filas */
+static void cv_model_text(int x, int y, const char *str) {
+    uint8_t cols[8];
+    uint8_t w, c, row;
+    
+    while (*str) {
+        w = glyph_cols(*str++, cols);
+        for (c = 0; c < w; c++, x++) {
+            for (row = 0; row < 8; row++) {
+                cv_model_pixel(x, y + row, ((cols[c] >> row) & 1) ? FB_OR : FB_CLEAR);
+            }
+        }
+    }
+}
+
+static void test_canvas(void) {
+    static ssd1306_dev * const tiles[2] = { &ssd1306_default, &dev2 };
+    
+    blank();
+    cv_init(tiles);
+    cv_clear();
+    cv_hline(SSD1306_WIDTH - 28, 5, 60);
+    cv_vline(SSD1306_WIDTH, 0, SSD1306_CANVAS_HEIGHT);
+    cv_rect_filled(SSD1306_WIDTH - 8, 10, 20, 12);
+    cv_set_pixel(SSD1306_CANVAS_WIDTH - 1, SSD1306_CANVAS_HEIGHT - 1);
+    cv_text(SSD1306_WIDTH - 9, 11, "ab");
+    cv_flush();
+    result(ssd1306_cur == &ssd1306_default, "cv_*: conservan la selección");
+    
+    cv_model_rect(SSD1306_WIDTH - 28, 5, 60, 1);
+    cv_model_rect(SSD1306_WIDTH, 0, 1, SSD1306_CANVAS_HEIGHT);
+    cv_model_rect(SSD1306_WIDTH - 8, 10, 20, 12);
+    cv_model_pixel(SSD1306_CANVAS_WIDTH - 1, SSD1306_CANVAS_HEIGHT - 1, FB_OR);
+    cv_model_text(SSD1306_WIDTH - 9, 11, "ab");
+    load_image(&ref, img);
+    check(&opt, "lienzo cv_*: panel 1");
+    load_image(&ref, img2);
+    check(&opt2, "lienzo cv_*: panel 2");
+}
+#endif
+#endif /* SSD1306_USE_MULTI */
+
+int main(int argc, char **argv) {
+    int i;
+    
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-a") == 0) show_screen = 1;
+    }
+    
+    /* Misma inicialización en todos; después ref solo recibe flujos crudos */
+    ssd1306_emu_init(&opt, SSD1306_ADDR, SSD1306_WIDTH, SSD1306_HEIGHT);
+    ssd1306_emu_init(&ref, SSD1306_ADDR, SSD1306_WIDTH, SSD1306_HEIGHT);
+    ssd1306_emu_init(&cap, SSD1306_ADDR, SSD1306_WIDTH, SSD1306_HEIGHT);
+    ssd1306_emu_attach(&opt);
+    ssd1306_emu_attach(&ref);
+    ssd1306_emu_attach(&cap);
+#if SSD1306_USE_MULTI
+    ssd1306_emu_init(&opt2, SSD1306_ADDR + 1, SSD1306_WIDTH, SSD1306_HEIGHT);
+    ssd1306_emu_attach(&opt2);
+    ssd1306_dev_setup(&dev2, SSD1306_ADDR + 1, fb2);
+    ssd1306_dev_init(&dev2);
+    fb_dev_init(&dev2);
+    ssd1306_select(&ssd1306_default);
+#endif
+    ssd1306_init();
+    ref.addr = NO_ADDR;
+    fb_init();
+    
+    test_emu_model();
+    test_clear();
+    test_position();
+#if SSD1306_USE_TEXT
+    test_text();
+#endif
+#if SSD1306_USE_FB_BAND
+    test_band();
+#else
+    test_spans();
+    test_flushes();
+#if SSD1306_USE_FB_ASYNC
+    test_async_cancel();
+#endif
+#endif
+#if SSD1306_USE_INIT_EX
+    test_init_ex();
+#endif
+#if SSD1306_USE_BIGNUM
+    test_bigfont();
+#endif
+#if SSD1306_USE_BIGNUM24
+    test_bignum24();
+#endif
+#if SSD1306_USE_MULTI
+    test_multi();
+#if SSD1306_USE_FB_CANVAS && SSD1306_CANVAS_TILES == 2
+    test_canvas();
+#endif
+#endif
+    
+    if (failures) {
+        printf("%d caso(s) con diferencias\n", failures);
+        return 1;
+    }
+    printf("todos los casos coinciden\n");
+    return 0;
+}
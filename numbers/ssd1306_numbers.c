@@ -7,30 +7,165 @@
 
 #if SSD1306_USE_NUMBERS
 
+/* ============================================
+ * CONVERSIÓN A DECIMAL
+ * ============================================
+ * Sin divisiones: cada dígito se obtiene restando su potencia de 10
+ * (como mucho 9 restas por dígito). En cc65 '/' y '%' son llamadas a
+ * rutinas de división del runtime; la resta es código en línea.
+ * Los dígitos quedan en num_digits sin ceros a la izquierda.
+ */
+static const uint16_t pow10_16[4] = { 10000, 1000, 100, 10 };
+
+static char num_digits[10];
+static uint8_t num_count;
+
+/* Convertir num empezando por la potencia pow10_16[first] */
+static void num_conv16(uint16_t num, uint8_t first) {
+    uint8_t i;
+    char c;
+    
+    for (i = first; i < 4; i++) {
+        c = '0';
+        while (num >= pow10_16[i]) {
+            num -= pow10_16[i];
+            c++;
+        }
+        if (num_count || c != '0') num_digits[num_count++] = c;
+    }
+    num_digits[num_count++] = '0' + (uint8_t)num;
+}
+
+/*
+ * Dar formato a los dígitos convertidos: signo, punto decimal, relleno
+ * y alineación. width = 0: sin relleno. Si no cabe en width se llena
+ * con '#'. Retorna la longitud escrita en buf (sin el '\0').
+ */
+static uint8_t num_finish(char *buf, uint8_t neg, uint8_t width, uint8_t decimals, uint8_t flags) {
+    uint8_t len, pad, i, d;
+    
+    if (decimals > SSD1306_NUM_MAX_DECIMALS) decimals = SSD1306_NUM_MAX_DECIMALS;
+    
+    /* Con decimales hace falta al menos un dígito entero: 5 → 0.05 */
+    if (num_count <= decimals) {
+        pad = decimals + 1 - num_count;
+        for (i = num_count; i > 0; i--) {
+            num_digits[i - 1 + pad] = num_digits[i - 1];
+        }
+        for (i = 0; i < pad; i++) {
+            num_digits[i] = '0';
+        }
+        num_count = decimals + 1;
+    }
+    
+    len = num_count + neg + (decimals ? 1 : 0);
+    if (width == 0) width = len;
+    if (width > SSD1306_NUM_MAX_WIDTH) width = SSD1306_NUM_MAX_WIDTH;
+    
+    if (len > width) {
+        for (i = 0; i < width; i++) {
+            buf[i] = '#';
+        }
+        buf[width] = '\0';
+        return width;
+    }
+    
+    pad = width - len;
+    i = 0;
+    if (!(flags & SSD1306_NUM_LEFT) && !(flags & SSD1306_NUM_ZERO)) {
+        while (pad) { buf[i++] = ' '; pad--; }
+    }
+    if (neg) buf[i++] = '-';
+    if (!(flags & SSD1306_NUM_LEFT)) {
+        while (pad) { buf[i++] = '0'; pad--; }
+    }
+    for (d = 0; d < num_count; d++) {
+        if (decimals && d == num_count - decimals) buf[i++] = '.';
+        buf[i++] = num_digits[d];
+    }
+    while (pad) { buf[i++] = ' '; pad--; }
+    buf[i] = '\0';
+    return width;
+}
+
+uint8_t ssd1306_format16(char *buf, uint16_t num, uint8_t width, uint8_t decimals, uint8_t flags) {
+    uint8_t neg = 0;
+    
+    if ((flags & SSD1306_NUM_SIGNED) && (int16_t)num < 0) {
+        neg = 1;
+        num = 0 - num;
+    }
+    num_count = 0;
+    num_conv16(num, 0);
+    return num_finish(buf, neg, width, decimals, flags);
+}
+
 /* Mostrar número decimal */
 void ssd1306_number(uint8_t col, uint8_t page, uint16_t num) {
     char buf[6];
-    uint8_t i = 5;
     
-    buf[5] = '\0';
-    do {
-        i--;
-        buf[i] = '0' + (num % 10);
-        num /= 10;
-    } while (num > 0 && i > 0);
-    
-    ssd1306_text(col, page, &buf[i]);
+    ssd1306_format16(buf, num, 0, 0, 0);
+    ssd1306_text(col, page, buf);
 }
 
 /* Mostrar número con signo */
 void ssd1306_number_signed(uint8_t col, uint8_t page, int16_t num) {
-    if (num < 0) {
-        ssd1306_char(col, page, '-');
-        ssd1306_number(col + 6, page, (uint16_t)(-num));
+    char buf[7];
+    
+    ssd1306_format16(buf, (uint16_t)num, 0, 0, SSD1306_NUM_SIGNED);
+    ssd1306_text(col, page, buf);
+}
+
+/* Campo de ancho fijo: siempre width caracteres en una transacción */
+void ssd1306_number_fixed(uint8_t col, uint8_t page, uint16_t num,
+                          uint8_t width, uint8_t decimals, uint8_t flags) {
+    char buf[SSD1306_NUM_MAX_WIDTH + 1];
+    
+    ssd1306_format16(buf, num, width, decimals, flags);
+    ssd1306_text(col, page, buf);
+}
+
+#if SSD1306_USE_NUMBERS_32
+static const uint32_t pow10_32[6] = {
+    1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 10000UL
+};
+
+uint8_t ssd1306_format32(char *buf, uint32_t num, uint8_t width, uint8_t decimals, uint8_t flags) {
+    uint8_t neg = 0;
+    uint8_t i;
+    char c;
+    
+    if ((flags & SSD1306_NUM_SIGNED) && (int32_t)num < 0) {
+        neg = 1;
+        num = 0 - num;
+    }
+    num_count = 0;
+    
+    if (num > 0xFFFF) {
+        /* Dígitos altos en 32 bits; el resto (< 10000) en 16 */
+        for (i = 0; i < 6; i++) {
+            c = '0';
+            while (num >= pow10_32[i]) {
+                num -= pow10_32[i];
+                c++;
+            }
+            if (num_count || c != '0') num_digits[num_count++] = c;
+        }
+        num_conv16((uint16_t)num, 1);
     } else {
-        ssd1306_number(col, page, (uint16_t)num);
+        num_conv16((uint16_t)num, 0);
     }
+    return num_finish(buf, neg, width, decimals, flags);
+}
+
+void ssd1306_number_fixed32(uint8_t col, uint8_t page, uint32_t num,
+                            uint8_t width, uint8_t decimals, uint8_t flags) {
+    char buf[SSD1306_NUM_MAX_WIDTH + 1];
+    
+    ssd1306_format32(buf, num, width, decimals, flags);
+    ssd1306_text(col, page, buf);
 }
+#endif /* SSD1306_USE_NUMBERS_32 */
 
 #endif /* SSD1306_USE_NUMBERS */
 
@@ -16,6 +16,35 @@ void ssd1306_number(uint8_t col, uint8_t page, uint16_t num);
 /* Mostrar número con signo (-32768 a 32767) */
 void ssd1306_number_signed(uint8_t col, uint8_t page, int16_t num);
 
+/*
+ * Formato de ancho fijo (conversión sin divisiones).
+ * width: caracteres (0 = los justos, máx. SSD1306_NUM_MAX_WIDTH).
+ * decimals: dígitos tras el punto (1234 con 2 → "12.34").
+ * Con SSD1306_NUM_SIGNED el valor se toma como int16_t / int32_t.
+ * Si no cabe en width se muestran '#'. Los valores de 8 bits usan la
+ * versión de 16.
+ */
+#define SSD1306_NUM_SIGNED          0x01    /* Valor con signo */
+#define SSD1306_NUM_ZERO            0x02    /* Rellenar con ceros (por defecto espacios) */
+#define SSD1306_NUM_LEFT            0x04    /* Alinear a la izquierda (por defecto derecha) */
+
+#define SSD1306_NUM_MAX_WIDTH       12      /* Signo + 10 dígitos + punto */
+#define SSD1306_NUM_MAX_DECIMALS    9
+
+/* Escribir en buf (width+1 bytes, o 13). Retorna la longitud */
+uint8_t ssd1306_format16(char *buf, uint16_t num, uint8_t width, uint8_t decimals, uint8_t flags);
+
+/* Mostrar en un campo de width caracteres: siempre lo sobrescribe entero */
+void ssd1306_number_fixed(uint8_t col, uint8_t page, uint16_t num,
+                          uint8_t width, uint8_t decimals, uint8_t flags);
+
+#if SSD1306_USE_NUMBERS_32
+uint8_t ssd1306_format32(char *buf, uint32_t num, uint8_t width, uint8_t decimals, uint8_t flags);
+
+void ssd1306_number_fixed32(uint8_t col, uint8_t page, uint32_t num,
+                            uint8_t width, uint8_t decimals, uint8_t flags);
+#endif /* SSD1306_USE_NUMBERS_32 */
+
 #endif /* SSD1306_USE_NUMBERS */
 
 #if SSD1306_USE_NUMBERS_HEX
@@ -28,4 +57,18 @@ void ssd1306_hex16(uint8_t col, uint8_t page, uint16_t num);
 
 #endif /* SSD1306_USE_NUMBERS_HEX */
 
+#if SSD1306_USE_MULTI
+/* Variantes con handle (ver ssd1306_dev en core) */
+#if SSD1306_USE_NUMBERS
+#define ssd1306_dev_number(dev, c, p, n)        (ssd1306_select(dev), ssd1306_number(c, p, n))
+#define ssd1306_dev_number_signed(dev, c, p, n) (ssd1306_select(dev), ssd1306_number_signed(c, p, n))
+#define ssd1306_dev_number_fixed(dev, c, p, n, w, d, f) \
+    (ssd1306_select(dev), ssd1306_number_fixed(c, p, n, w, d, f))
+#endif
+#if SSD1306_USE_NUMBERS_HEX
+#define ssd1306_dev_hex8(dev, c, p, n)          (ssd1306_select(dev), ssd1306_hex8(c, p, n))
+#define ssd1306_dev_hex16(dev, c, p, n)         (ssd1306_select(dev), ssd1306_hex16(c, p, n))
+#endif
+#endif /* SSD1306_USE_MULTI */
+
 #endif /* SSD1306_NUMBERS_H */
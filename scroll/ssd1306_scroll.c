@@ -7,28 +7,29 @@
 
 #if SSD1306_USE_SCROLL
 
+/* Configurar y activar scroll horizontal (1 transacción) */
+static void scroll_start(uint8_t dir, uint8_t start_page, uint8_t end_page, uint8_t speed) {
+    uint8_t cmds[8];
+    
+    cmds[0] = dir;          /* 0x26 derecha / 0x27 izquierda */
+    cmds[1] = 0x00;         /* Dummy */
+    cmds[2] = start_page;   /* Start page */
+    cmds[3] = speed;        /* Speed (0-7) */
+    cmds[4] = end_page;     /* End page */
+    cmds[5] = 0x00;         /* Dummy */
+    cmds[6] = 0xFF;         /* Dummy */
+    cmds[7] = 0x2F;         /* Activate scroll */
+    ssd1306_cmd_list(cmds, 8);
+}
+
 /* Scroll derecha */
 void ssd1306_scroll_right(uint8_t start_page, uint8_t end_page, uint8_t speed) {
-    ssd1306_cmd(0x26);        /* Right scroll */
-    ssd1306_cmd(0x00);        /* Dummy */
-    ssd1306_cmd(start_page);  /* Start page */
-    ssd1306_cmd(speed);       /* Speed (0-7) */
-    ssd1306_cmd(end_page);    /* End page */
-    ssd1306_cmd(0x00);        /* Dummy */
-    ssd1306_cmd(0xFF);        /* Dummy */
-    ssd1306_cmd(0x2F);        /* Activate scroll */
+    scroll_start(0x26, start_page, end_page, speed);
 }
 
 /* Scroll izquierda */
 void ssd1306_scroll_left(uint8_t start_page, uint8_t end_page, uint8_t speed) {
-    ssd1306_cmd(0x27);        /* Left scroll */
-    ssd1306_cmd(0x00);        /* Dummy */
-    ssd1306_cmd(start_page);  /* Start page */
-    ssd1306_cmd(speed);       /* Speed (0-7) */
-    ssd1306_cmd(end_page);    /* End page */
-    ssd1306_cmd(0x00);        /* Dummy */
-    ssd1306_cmd(0xFF);        /* Dummy */
-    ssd1306_cmd(0x2F);        /* Activate scroll */
+    scroll_start(0x27, start_page, end_page, speed);
 }
 
 /* Detener scroll */
@@ -45,6 +45,10 @@
 #include "bignum/ssd1306_bigfont.h"
 #endif
 
+#if SSD1306_USE_BIGNUM24
+#include "bignum/ssd1306_bignum.h"
+#endif
+
 /* Gráficos */
 #if SSD1306_USE_GRAPHICS || SSD1306_USE_RECT || SSD1306_USE_PROGRESS || SSD1306_USE_ICONS
 #include "graphics/ssd1306_graphics.h"
@@ -60,4 +64,9 @@
 #include "framebuffer/ssd1306_framebuffer.h"
 #endif
 
+/* Lienzo sobre varios paneles */
+#if SSD1306_USE_FB_CANVAS
+#include "framebuffer/ssd1306_canvas.h"
+#endif
+
 #endif /* SSD1306_H */
@@ -22,16 +22,85 @@
 #define SSD1306_ADDR        0x3C    /* Dirección I2C (0x3C o 0x3D) */
 #endif
 
+/* Panel: fija tamaño, multiplex, COM pins y offset de columnas */
+#define SSD1306_PANEL_128X32        0
+#define SSD1306_PANEL_128X64        1
+#define SSD1306_PANEL_96X16         2
+#define SSD1306_PANEL_64X48         3   /* Columnas 32-95 de la GDDRAM */
+#define SSD1306_PANEL_CUSTOM        9   /* Definir WIDTH/HEIGHT (y MUX/COMPINS/COL_OFFSET si hace falta) */
+
+#ifndef SSD1306_PANEL
+#define SSD1306_PANEL       SSD1306_PANEL_128X32
+#endif
+
+#if SSD1306_PANEL == SSD1306_PANEL_128X64
+#ifndef SSD1306_WIDTH
+#define SSD1306_WIDTH       128
+#endif
+#ifndef SSD1306_HEIGHT
+#define SSD1306_HEIGHT      64
+#endif
+#elif SSD1306_PANEL == SSD1306_PANEL_96X16
+#ifndef SSD1306_WIDTH
+#define SSD1306_WIDTH       96
+#endif
+#ifndef SSD1306_HEIGHT
+#define SSD1306_HEIGHT      16
+#endif
+#elif SSD1306_PANEL == SSD1306_PANEL_64X48
+#ifndef SSD1306_WIDTH
+#define SSD1306_WIDTH       64
+#endif
+#ifndef SSD1306_HEIGHT
+#define SSD1306_HEIGHT      48
+#endif
+#ifndef SSD1306_COL_OFFSET
+#define SSD1306_COL_OFFSET  32
+#endif
+#else
 #ifndef SSD1306_WIDTH
 #define SSD1306_WIDTH       128
 #endif
-
 #ifndef SSD1306_HEIGHT
 #define SSD1306_HEIGHT      32      /* 32 o 64 */
 #endif
+#endif
 
 #ifndef SSD1306_PAGES
-#define SSD1306_PAGES       4       /* HEIGHT/8 */
+#define SSD1306_PAGES       (SSD1306_HEIGHT / 8)
+#endif
+
+#ifndef SSD1306_COL_OFFSET
+#define SSD1306_COL_OFFSET  0       /* Primera columna de GDDRAM visible */
+#endif
+
+#ifndef SSD1306_MUX
+#define SSD1306_MUX         (SSD1306_HEIGHT - 1)    /* Argumento de 0xA8 */
+#endif
+
+#ifndef SSD1306_COMPINS
+#define SSD1306_COMPINS     (SSD1306_HEIGHT > 32 ? 0x12 : 0x02)    /* Argumento de 0xDA */
+#endif
+
+#ifndef SSD1306_HOST_MOCK
+#define SSD1306_HOST_MOCK   0       /* 1 = compilar en PC con host/i2c_mock.c */
+#endif
+
+/* Transporte (ver transport/ssd1306_transport.h) */
+#define SSD1306_TRANSPORT_I2C       0   /* ../i2c/i2c.h */
+#define SSD1306_TRANSPORT_SPI       1   /* SPI 4 hilos con funciones del usuario */
+#define SSD1306_TRANSPORT_MOCK      2   /* host/i2c_mock.c */
+
+#ifndef SSD1306_TRANSPORT
+#if SSD1306_HOST_MOCK
+#define SSD1306_TRANSPORT   SSD1306_TRANSPORT_MOCK
+#else
+#define SSD1306_TRANSPORT   SSD1306_TRANSPORT_I2C
+#endif
+#endif
+
+#ifndef SSD1306_TRANSPORT_ASM
+#define SSD1306_TRANSPORT_ASM       0   /* 1 = envío en bloque en ensamblador (I2C, cc65) */
 #endif
 
 /* ============================================
@@ -43,6 +112,16 @@
 #define SSD1306_USE_CORE            1
 #endif
 
+/* Varios displays (ssd1306_dev): dirección, estado y framebuffer por display */
+#ifndef SSD1306_USE_MULTI
+#define SSD1306_USE_MULTI           0
+#endif
+
+/* ssd1306_init_ex(): arranque en caliente y encendido diferido */
+#ifndef SSD1306_USE_INIT_EX
+#define SSD1306_USE_INIT_EX         0
+#endif
+
 /* TEXTO PEQUEÑO 5x7 */
 #ifndef SSD1306_USE_FONT_5X7_FULL
 #define SSD1306_USE_FONT_5X7_FULL   0   /* ASCII 32-126 (~475 bytes) */
@@ -56,11 +135,23 @@
 #define SSD1306_USE_TEXT_INV        0   /* ssd1306_text_inv() */
 #endif
 
+#ifndef SSD1306_USE_TEXT_FIELD
+#define SSD1306_USE_TEXT_FIELD      0   /* ssd1306_field_set(): solo reenvía celdas cambiadas */
+#endif
+
+#ifndef SSD1306_FIELD_MAX
+#define SSD1306_FIELD_MAX           10  /* Caracteres máximos por campo (RAM por campo) */
+#endif
+
 /* NÚMEROS PEQUEÑOS */
 #ifndef SSD1306_USE_NUMBERS
 #define SSD1306_USE_NUMBERS         0   /* ssd1306_number() */
 #endif
 
+#ifndef SSD1306_USE_NUMBERS_32
+#define SSD1306_USE_NUMBERS_32      0   /* ssd1306_format32(), ssd1306_number_fixed32() */
+#endif
+
 #ifndef SSD1306_USE_NUMBERS_HEX
 #define SSD1306_USE_NUMBERS_HEX     0   /* ssd1306_hex8/16() */
 #endif
@@ -74,6 +165,11 @@
 #define SSD1306_BIGNUM_LETTERS      0   /* Letras A-Z (~130 bytes) */
 #endif
 
+/* NÚMEROS GRANDES 24x32px por bloques (compatible con BIGNUM) */
+#ifndef SSD1306_USE_BIGNUM24
+#define SSD1306_USE_BIGNUM24        0   /* ssd1306_bignum24_*(), ssd1306_bigfield24 */
+#endif
+
 /* GRÁFICOS DIRECTOS (sin framebuffer) */
 #ifndef SSD1306_USE_GRAPHICS
 #define SSD1306_USE_GRAPHICS        0   /* ssd1306_hline() */
@@ -128,6 +224,49 @@
 #define SSD1306_USE_FB_SPRITE       0   /* Sprites con OR/XOR */
 #endif
 
+#ifndef SSD1306_USE_FB_TEXT
+#define SSD1306_USE_FB_TEXT         0   /* fb_text()/fb_char() en cualquier y (requiere fuente 5x7) */
+#endif
+
+#ifndef SSD1306_USE_FB_DIRTY
+#define SSD1306_USE_FB_DIRTY        0   /* Regiones sucias + fb_flush_dirty() (+8 bytes RAM) */
+#endif
+
+#ifndef SSD1306_USE_FB_SHADOW
+#define SSD1306_USE_FB_SHADOW       0   /* fb_flush() solo envía bytes cambiados (+512 bytes RAM) */
+#endif
+
+#ifndef SSD1306_USE_FB_ASYNC
+#define SSD1306_USE_FB_ASYNC        0   /* fb_flush_begin()/fb_flush_step() (+131 bytes RAM) */
+#endif
+
+#ifndef SSD1306_USE_FB_BAND
+#define SSD1306_USE_FB_BAND         0   /* fb_render() por bandas: buffer de 1 página (128 B en vez de 512) */
+#endif
+
+#ifndef SSD1306_USE_FB_CANVAS
+#define SSD1306_USE_FB_CANVAS       0   /* Lienzo cv_* sobre varios paneles (requiere MULTI) */
+#endif
+
+#ifndef SSD1306_CANVAS_COLS
+#define SSD1306_CANVAS_COLS         2   /* Paneles en horizontal (2 x 128x32 = 256x32) */
+#endif
+
+#ifndef SSD1306_CANVAS_ROWS
+#define SSD1306_CANVAS_ROWS         1   /* Paneles en vertical */
+#endif
+
+#ifndef SSD1306_FB_SHADOW_GAP
+#define SSD1306_FB_SHADOW_GAP       8   /* Huecos <= N bytes iguales se unen al tramo */
+#endif
+
+/* ============================================
+ * ESTADÍSTICAS - Contadores de bus en el core
+ * ============================================ */
+#ifndef SSD1306_USE_STATS
+#define SSD1306_USE_STATS           0   /* ssd1306_get_stats() (+18 bytes RAM) */
+#endif
+
 /* No usados (para compatibilidad) */
 #ifndef SSD1306_USE_FONT_5X7_UPPER
 #define SSD1306_USE_FONT_5X7_UPPER  0
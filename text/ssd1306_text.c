@@ -5,51 +5,38 @@
 #include "ssd1306_text.h"
 #include "../core/ssd1306_core.h"
 #include "../fonts/ssd1306_font.h"
-#include "../../i2c/i2c.h"
 
 #if SSD1306_USE_TEXT
 
 /* Escribir un caracter */
 void ssd1306_char(uint8_t col, uint8_t page, char c) {
-    uint8_t i;
     const uint8_t *glyph;
     uint8_t width = font_get_width();
     
-    ssd1306_set_pos(col, page);
-    
-    i2c_start(SSD1306_ADDR, I2C_WRITE);
-    i2c_write_byte(SSD1306_DATA);
+    ssd1306_data_begin(col, page);
     
     glyph = font_get_glyph(c);
-    for (i = 0; i < width; i++) {
-        i2c_write_byte(glyph[i]);
-    }
-    i2c_write_byte(0x00); /* Espacio entre caracteres */
+    ssd1306_data_buf(glyph, width);
+    ssd1306_data_put(0x00); /* Espacio entre caracteres */
     
-    i2c_stop();
+    ssd1306_data_end();
 }
 
 /* Escribir texto */
 void ssd1306_text(uint8_t col, uint8_t page, const char *str) {
-    uint8_t i;
     const uint8_t *glyph;
     uint8_t width = font_get_width();
     
-    ssd1306_set_pos(col, page);
-    
-    i2c_start(SSD1306_ADDR, I2C_WRITE);
-    i2c_write_byte(SSD1306_DATA);
+    ssd1306_data_begin(col, page);
     
     while (*str) {
         glyph = font_get_glyph(*str);
-        for (i = 0; i < width; i++) {
-            i2c_write_byte(glyph[i]);
-        }
-        i2c_write_byte(0x00); /* Espacio */
+        ssd1306_data_buf(glyph, width);
+        ssd1306_data_put(0x00); /* Espacio */
         str++;
     }
     
-    i2c_stop();
+    ssd1306_data_end();
 }
 
 #if SSD1306_USE_TEXT_INV
@@ -59,22 +46,83 @@ void ssd1306_text_inv(uint8_t col, uint8_t page, const char *str) {
     const uint8_t *glyph;
     uint8_t width = font_get_width();
     
-    ssd1306_set_pos(col, page);
-    
-    i2c_start(SSD1306_ADDR, I2C_WRITE);
-    i2c_write_byte(SSD1306_DATA);
+    ssd1306_data_begin(col, page);
     
     while (*str) {
         glyph = font_get_glyph(*str);
         for (i = 0; i < width; i++) {
-            i2c_write_byte(glyph[i] ^ 0xFF);
+            ssd1306_data_put(glyph[i] ^ 0xFF);
         }
-        i2c_write_byte(0xFF); /* Espacio invertido */
+        ssd1306_data_put(0xFF); /* Espacio invertido */
         str++;
     }
     
-    i2c_stop();
+    ssd1306_data_end();
 }
 #endif /* SSD1306_USE_TEXT_INV */
 
+#if SSD1306_USE_TEXT_FIELD
+/*
+ * Un tramo nuevo cuesta dirección + posición + byte de control (unos 8
+ * bytes en I2C); reenviar una celda igual cuesta 6. Por eso un hueco de
+ * FIELD_GAP celdas sin cambios se envía dentro del tramo.
+ */
+#define FIELD_GAP   1
+
+void ssd1306_field_init(ssd1306_field *field, uint8_t col, uint8_t page, uint8_t width) {
+    field->col = col;
+    field->page = page;
+    field->width = (width > SSD1306_FIELD_MAX) ? SSD1306_FIELD_MAX : width;
+    ssd1306_field_invalidate(field);
+}
+
+void ssd1306_field_invalidate(ssd1306_field *field) {
+    uint8_t i;
+    for (i = 0; i < SSD1306_FIELD_MAX; i++) {
+        field->last[i] = 0;     /* Nunca coincide con un carácter */
+    }
+}
+
+void ssd1306_field_set(ssd1306_field *field, const char *str) {
+    char next[SSD1306_FIELD_MAX];
+    uint8_t width = font_get_width();
+    uint8_t i, start, end, gap;
+    
+    /* Texto nuevo, recortado o rellenado con espacios */
+    for (i = 0; i < field->width; i++) {
+        next[i] = *str ? *str++ : ' ';
+    }
+    
+    i = 0;
+    while (i < field->width) {
+        if (next[i] == field->last[i]) {
+            i++;
+            continue;
+        }
+        
+        /* Tramo: desde la primera celda cambiada hasta la última que no
+         * va seguida de más de FIELD_GAP celdas iguales */
+        start = i;
+        end = i;
+        gap = 0;
+        for (i++; i < field->width && gap <= FIELD_GAP; i++) {
+            if (next[i] != field->last[i]) {
+                end = i;
+                gap = 0;
+            } else {
+                gap++;
+            }
+        }
+        
+        ssd1306_data_begin(field->col + start * (width + 1), field->page);
+        for (i = start; i <= end; i++) {
+            ssd1306_data_buf(font_get_glyph(next[i]), width);
+            ssd1306_data_put(0x00);
+            field->last[i] = next[i];
+        }
+        ssd1306_data_end();
+    }
+}
+#endif /* SSD1306_USE_TEXT_FIELD */
+
 #endif /* SSD1306_USE_TEXT */
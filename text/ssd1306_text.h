@@ -21,6 +21,38 @@ void ssd1306_text(uint8_t col, uint8_t page, const char *str);
 void ssd1306_text_inv(uint8_t col, uint8_t page, const char *str);
 #endif
 
+#if SSD1306_USE_TEXT_FIELD
+/*
+ * Campo de texto: guarda lo último mostrado y ssd1306_field_set() envía
+ * solo las celdas que cambian, agrupadas en tramos. Si el texto nuevo es
+ * más corto, el resto del campo se rellena con espacios.
+ */
+typedef struct {
+    uint8_t col;                    /* Columna en píxeles */
+    uint8_t page;
+    uint8_t width;                  /* Ancho en caracteres (<= SSD1306_FIELD_MAX) */
+    char last[SSD1306_FIELD_MAX];   /* Contenido mostrado */
+} ssd1306_field;
+
+/* Preparar un campo; el primer field_set lo dibuja entero */
+void ssd1306_field_init(ssd1306_field *field, uint8_t col, uint8_t page, uint8_t width);
+
+/* Mostrar str en el campo enviando solo lo que cambia */
+void ssd1306_field_set(ssd1306_field *field, const char *str);
+
+/* Forzar redibujo completo en el próximo field_set (p.ej. tras ssd1306_clear) */
+void ssd1306_field_invalidate(ssd1306_field *field);
+#endif /* SSD1306_USE_TEXT_FIELD */
+
+#if SSD1306_USE_MULTI
+/* Variantes con handle (ver ssd1306_dev en core) */
+#define ssd1306_dev_char(dev, c, p, ch)     (ssd1306_select(dev), ssd1306_char(c, p, ch))
+#define ssd1306_dev_text(dev, c, p, s)      (ssd1306_select(dev), ssd1306_text(c, p, s))
+#if SSD1306_USE_TEXT_INV
+#define ssd1306_dev_text_inv(dev, c, p, s)  (ssd1306_select(dev), ssd1306_text_inv(c, p, s))
+#endif
+#endif /* SSD1306_USE_MULTI */
+
 #endif /* SSD1306_USE_TEXT */
 
 #endif /* SSD1306_TEXT_H */
@@ -0,0 +1,35 @@
+/**
+ * ssd1306_transport.c - Funciones de la capa de transporte
+ * 
+ * El resto de operaciones son macros en ssd1306_transport.h.
+ */
+
+#include "ssd1306_transport.h"
+
+#if SSD1306_TRANSPORT != SSD1306_TRANSPORT_SPI
+#if SSD1306_USE_MULTI
+uint8_t ssd1306_t_addr = SSD1306_ADDR;
+#endif
+
+uint8_t ssd1306_t_probe(void) {
+    uint8_t ack;
+    
+    ack = i2c_start(SSD1306_T_ADDRESS, I2C_WRITE);
+    i2c_stop();
+    return ack;
+}
+#endif
+
+#if !(SSD1306_TRANSPORT_ASM && SSD1306_TRANSPORT == SSD1306_TRANSPORT_I2C)
+void ssd1306_t_write_buf(const uint8_t *data, uint8_t n) {
+    while (n--) {
+        SSD1306_T_WRITE(*data++);
+    }
+}
+
+void ssd1306_t_write_repeat(uint8_t value, uint8_t n) {
+    while (n--) {
+        SSD1306_T_WRITE(value);
+    }
+}
+#endif
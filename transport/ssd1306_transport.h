@@ -0,0 +1,113 @@
+/**
+ * ssd1306_transport.h - Capa de transporte SSD1306 (I2C / SPI / mock)
+ * 
+ * Único punto de contacto con el bus. Se elige en compilación con
+ * SSD1306_TRANSPORT (ver ssd1306_config.h); cada operación es una
+ * macro, así que en cc65 no añade ni una llamada respecto al driver.
+ * 
+ * Operaciones:
+ *   SSD1306_T_BEGIN_CMD()     Abrir transacción: todo lo que sigue son comandos
+ *   SSD1306_T_BEGIN_DATA()    Abrir transacción: todo lo que sigue son datos
+ *   SSD1306_T_WRITE(b)        Enviar un byte
+ *   ssd1306_t_write_buf(p,n)  Enviar n bytes de un buffer
+ *   ssd1306_t_write_repeat(v,n)  Enviar n veces el byte v
+ *   SSD1306_T_END()           Cerrar transacción
+ * 
+ * Transacciones mixtas (comandos de posición + datos sin cerrar):
+ *   SSD1306_T_BEGIN()         Abrir sin modo
+ *   SSD1306_T_CMD(c)          Un comando (I2C: byte de control Co=1)
+ *   SSD1306_T_DATA()          El resto son datos
+ * 
+ * Solo el core usa esta capa; el resto de módulos pasan por el core.
+ */
+
+#ifndef SSD1306_TRANSPORT_H
+#define SSD1306_TRANSPORT_H
+
+#include <stdint.h>
+#include <ssd1306/ssd1306_config.h>
+
+/* Bytes de control I2C */
+#define SSD1306_CMD         0x00
+#define SSD1306_DATA        0x40
+#define SSD1306_CMD_CO      0x80    /* Comando con Co=1: sigue otro byte de control */
+
+#if SSD1306_TRANSPORT == SSD1306_TRANSPORT_SPI
+
+/* ============================================
+ * SPI 4 hilos: funciones que aporta el usuario
+ * ============================================ */
+
+/* Chip select: 0 = activo */
+void ssd1306_spi_cs(uint8_t level);
+
+/* Pin D/C: 0 = comando, 1 = datos */
+void ssd1306_spi_dc(uint8_t level);
+
+/* Enviar un byte por MOSI/SCK */
+void ssd1306_spi_write(uint8_t data);
+
+/* Con SSD1306_USE_MULTI, ssd1306_spi_cs() puede elegir el pin CS según
+ * ssd1306_cur->addr (el campo sirve de identificador del display) */
+
+#define SSD1306_T_ADDR_BYTES    0       /* SPI no envía dirección */
+#define SSD1306_T_MODE_BYTES    0       /* El modo va en el pin D/C */
+#define SSD1306_T_CMD_BYTES     1
+
+#define SSD1306_T_PROBE()       1       /* Sin ACK: se asume presente */
+#define SSD1306_T_BEGIN()       ssd1306_spi_cs(0)
+#define SSD1306_T_CMD(c)        do { ssd1306_spi_dc(0); ssd1306_spi_write(c); } while (0)
+#define SSD1306_T_DATA()        ssd1306_spi_dc(1)
+#define SSD1306_T_BEGIN_CMD()   do { ssd1306_spi_cs(0); ssd1306_spi_dc(0); } while (0)
+#define SSD1306_T_BEGIN_DATA()  do { ssd1306_spi_cs(0); ssd1306_spi_dc(1); } while (0)
+#define SSD1306_T_WRITE(b)      ssd1306_spi_write(b)
+#define SSD1306_T_END()         ssd1306_spi_cs(1)
+
+#else
+
+/* ============================================
+ * I2C (driver real o host/i2c_mock.c)
+ * ============================================ */
+
+#if SSD1306_TRANSPORT == SSD1306_TRANSPORT_MOCK
+#include "../host/i2c_mock.h"
+#else
+#include "../../i2c/i2c.h"
+#endif
+
+/* Dirección I2C: fija, o la del display seleccionado (SSD1306_USE_MULTI) */
+#if SSD1306_USE_MULTI
+extern uint8_t ssd1306_t_addr;
+#define SSD1306_T_ADDRESS       ssd1306_t_addr
+#else
+#define SSD1306_T_ADDRESS       SSD1306_ADDR
+#endif
+
+#define SSD1306_T_ADDR_BYTES    1       /* Byte de dirección tras START */
+#define SSD1306_T_MODE_BYTES    1       /* Byte de control 0x00 / 0x40 */
+#define SSD1306_T_CMD_BYTES     2       /* 0x80 + comando */
+
+/* Comprobar que el display responde (START + STOP) */
+uint8_t ssd1306_t_probe(void);
+
+#define SSD1306_T_PROBE()       ssd1306_t_probe()
+#define SSD1306_T_BEGIN()       i2c_start(SSD1306_T_ADDRESS, I2C_WRITE)
+#define SSD1306_T_CMD(c)        do { i2c_write_byte(SSD1306_CMD_CO); i2c_write_byte(c); } while (0)
+#define SSD1306_T_DATA()        i2c_write_byte(SSD1306_DATA)
+#define SSD1306_T_BEGIN_CMD()   do { SSD1306_T_BEGIN(); i2c_write_byte(SSD1306_CMD); } while (0)
+#define SSD1306_T_BEGIN_DATA()  do { SSD1306_T_BEGIN(); SSD1306_T_DATA(); } while (0)
+#define SSD1306_T_WRITE(b)      i2c_write_byte(b)
+#define SSD1306_T_END()         i2c_stop()
+
+#endif
+
+/*
+ * Envío en bloque (común a todos los transportes). Con I2C y
+ * SSD1306_TRANSPORT_ASM=1 se usan las versiones de
+ * ssd1306_transport_i2c.s: un bucle en ensamblador que llama al
+ * driver con el byte ya en A, sin apilar argumentos por byte.
+ */
+void ssd1306_t_write_buf(const uint8_t *data, uint8_t n);
+void ssd1306_t_write_repeat(uint8_t value, uint8_t n);
+
+#endif /* SSD1306_TRANSPORT_H */
@@ -0,0 +1,57 @@
+;
+; ssd1306_transport_i2c.s - Envío en bloque por I2C (cc65)
+;
+; Versiones en ensamblador de ssd1306_t_write_buf() y
+; ssd1306_t_write_repeat() para el transporte I2C. El bucle pasa cada
+; byte al driver en A (i2c_write_byte es __fastcall__), sin el
+; pusha/jsr/ldy por byte que genera cc65 para el bucle en C.
+;
+; Usar con SSD1306_TRANSPORT_ASM=1 y añadir este archivo al Makefile.
+;
+
+        .export     _ssd1306_t_write_buf
+        .export     _ssd1306_t_write_repeat
+        .import     _i2c_write_byte
+        .import     popa, popax
+
+.zeropage
+
+wb_ptr:     .res    2           ; No lo toca el código C (usa ptr1-ptr4)
+
+.bss
+
+wb_count:   .res    1
+wb_value:   .res    1
+
+.code
+
+; void __fastcall__ ssd1306_t_write_buf(const uint8_t *data, uint8_t n)
+_ssd1306_t_write_buf:
+        sta     wb_count
+        jsr     popax
+        sta     wb_ptr
+        stx     wb_ptr+1
+        lda     wb_count
+        beq     @done
+@loop:  ldy     #0
+        lda     (wb_ptr),y
+        jsr     _i2c_write_byte
+        inc     wb_ptr
+        bne     @next
+        inc     wb_ptr+1
+@next:  dec     wb_count
+        bne     @loop
+@done:  rts
+
+; void __fastcall__ ssd1306_t_write_repeat(uint8_t value, uint8_t n)
+_ssd1306_t_write_repeat:
+        sta     wb_count
+        jsr     popa
+        sta     wb_value
+        lda     wb_count
+        beq     @done
+@loop:  lda     wb_value
+        jsr     _i2c_write_byte
+        dec     wb_count
+        bne     @loop
+@done:  rts